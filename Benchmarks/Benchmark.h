@@ -0,0 +1,46 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+
+namespace Pargon::Benchmarks
+{
+	void RunMatrix();
+	void RunSkinning();
+
+	// Runs function repeatedly for at least a fixed time several times over and reports the fastest run, which is the
+	// least disturbed by the rest of the system, as nanoseconds for each of the items the function processes.
+	template <typename Function>
+	void Measure(const char* name, int items, Function&& function)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		constexpr int runs = 5;
+		constexpr double minimumSeconds = 0.1;
+
+		function();
+
+		auto fastest = std::numeric_limits<double>::max();
+
+		for (auto run = 0; run < runs; run++)
+		{
+			auto iterations = 0;
+			auto seconds = 0.0;
+			auto start = Clock::now();
+
+			do
+			{
+				function();
+				iterations++;
+				seconds = std::chrono::duration<double>(Clock::now() - start).count();
+			}
+			while (seconds < minimumSeconds);
+
+			fastest = std::min(fastest, seconds / iterations);
+		}
+
+		std::printf("%-48s %10.2f ns\n", name, fastest * 1.0e9 / items);
+	}
+}
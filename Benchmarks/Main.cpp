@@ -0,0 +1,8 @@
+#include "Benchmark.h"
+
+auto main() -> int
+{
+	Pargon::Benchmarks::RunMatrix();
+	Pargon::Benchmarks::RunSkinning();
+	return 0;
+}
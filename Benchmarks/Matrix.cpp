@@ -0,0 +1,55 @@
+#include "Benchmark.h"
+
+#include "Pargon/Math/Matrix.h"
+#include "Pargon/Math/Quaternion.h"
+
+#include <random>
+#include <vector>
+
+using namespace Pargon;
+
+namespace
+{
+	constexpr int _matrixCount = 1024;
+
+	auto CreateMatrices(std::mt19937& random) -> std::vector<Matrix4x4>
+	{
+		std::uniform_real_distribution<float> coordinate(-1.0f, 1.0f);
+		std::vector<Matrix4x4> matrices;
+
+		for (auto i = 0; i < _matrixCount; i++)
+		{
+			auto axis = Vector3{ coordinate(random), coordinate(random), coordinate(random) + 2.0f }.Normalized();
+			auto rotation = Quaternion::CreateFromAxisAngle(axis, Rotation::FromRadians(coordinate(random) * 3.0f));
+			matrices.push_back(Matrix4x4::CreateTransform({ coordinate(random), coordinate(random), coordinate(random) }, { 1.0f, 1.0f, 1.0f }, rotation, { 0.0f, 0.0f, 0.0f }));
+		}
+
+		return matrices;
+	}
+}
+
+void Pargon::Benchmarks::RunMatrix()
+{
+	std::mt19937 random(1);
+	auto left = CreateMatrices(random);
+	auto right = CreateMatrices(random);
+	std::vector<Matrix4x4> results(_matrixCount);
+
+	std::printf("Matrix4x4 multiplication, %d matrices, per multiply\n", _matrixCount);
+
+	// Independent products measure throughput, and the chain feeds each product into the next to measure latency.
+
+	Benchmarks::Measure("  operator*, independent", _matrixCount, [&]()
+	{
+		for (auto i = 0; i < _matrixCount; i++)
+			results[i] = left[i] * right[i];
+	});
+
+	Benchmarks::Measure("  operator*=, chained", _matrixCount, [&]()
+	{
+		auto& product = results[0];
+
+		for (auto i = 0; i < _matrixCount; i++)
+			product *= right[i];
+	});
+}
@@ -0,0 +1,115 @@
+#include "Benchmark.h"
+
+#include "Pargon/Math/Affine.h"
+#include "Pargon/Math/Matrix.h"
+#include "Pargon/Math/Quaternion.h"
+#include "Pargon/Math/Skinning.h"
+#include "Pargon/Math/Stream.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace Pargon;
+
+namespace
+{
+	constexpr int _vertexCount = 16384;
+	constexpr int _boneCount = 64;
+	constexpr int _influences = 4;
+
+	struct Mesh
+	{
+		std::vector<Vector3> Positions;
+		std::vector<Vector3> Normals;
+		std::vector<std::uint16_t> Bones;
+		std::vector<float> Weights;
+		std::vector<Matrix4x4> Matrices;
+		std::vector<Affine3x4> Affines;
+	};
+
+	auto CreateMesh() -> Mesh
+	{
+		std::mt19937 random(1);
+		std::uniform_real_distribution<float> coordinate(-1.0f, 1.0f);
+		std::uniform_real_distribution<float> weight(0.1f, 1.0f);
+		std::uniform_int_distribution<int> bone(0, _boneCount - 1);
+
+		Mesh mesh;
+
+		for (auto i = 0; i < _vertexCount; i++)
+		{
+			mesh.Positions.push_back({ coordinate(random), coordinate(random), coordinate(random) });
+			mesh.Normals.push_back(Vector3{ coordinate(random), coordinate(random), 1.0f }.Normalized());
+
+			float weights[_influences];
+			auto total = 0.0f;
+
+			for (auto& value : weights)
+			{
+				value = weight(random);
+				total += value;
+			}
+
+			for (auto value : weights)
+			{
+				mesh.Bones.push_back(static_cast<std::uint16_t>(bone(random)));
+				mesh.Weights.push_back(value / total);
+			}
+		}
+
+		for (auto i = 0; i < _boneCount; i++)
+		{
+			auto axis = Vector3{ coordinate(random), coordinate(random), coordinate(random) + 2.0f }.Normalized();
+			auto rotation = Quaternion::CreateFromAxisAngle(axis, Rotation::FromRadians(coordinate(random) * 3.0f));
+			auto matrix = Matrix4x4::CreateTransform({ coordinate(random), coordinate(random), coordinate(random) }, { 1.0f, 1.0f, 1.0f }, rotation, { 0.0f, 0.0f, 0.0f });
+
+			mesh.Matrices.push_back(matrix);
+			mesh.Affines.push_back(Affine3x4::CreateFromMatrix(matrix));
+		}
+
+		return mesh;
+	}
+
+	template <typename Palette>
+	void MeasureArrays(const char* name, const Mesh& mesh, const Palette* palette, SkinningMethod method)
+	{
+		std::vector<Vector3> positions(_vertexCount);
+		std::vector<Vector3> normals(_vertexCount);
+
+		Benchmarks::Measure(name, _vertexCount, [&]()
+		{
+			SkinVertices(mesh.Positions.data(), mesh.Normals.data(), _vertexCount, mesh.Bones.data(), mesh.Weights.data(), _influences, palette, positions.data(), normals.data(), method);
+		});
+	}
+
+	template <typename Palette>
+	void MeasureStreams(const char* name, const Mesh& mesh, const Palette* palette, SkinningMethod method)
+	{
+		Vector3Stream sourcePositions(mesh.Positions.data(), _vertexCount);
+		Vector3Stream sourceNormals(mesh.Normals.data(), _vertexCount);
+		Vector3Stream positions(_vertexCount);
+		Vector3Stream normals(_vertexCount);
+
+		Benchmarks::Measure(name, _vertexCount, [&]()
+		{
+			SkinVertices(sourcePositions, sourceNormals, 0, _vertexCount, mesh.Bones.data(), mesh.Weights.data(), _influences, palette, positions, normals, method);
+		});
+	}
+}
+
+void Pargon::Benchmarks::RunSkinning()
+{
+	auto mesh = CreateMesh();
+
+	std::printf("SkinVertices, %d vertices with %d influences, per vertex\n", _vertexCount, _influences);
+
+	MeasureArrays("  Arrays, Matrix4x4, BlendMatrices", mesh, mesh.Matrices.data(), SkinningMethod::BlendMatrices);
+	MeasureArrays("  Arrays, Matrix4x4, BlendPositions", mesh, mesh.Matrices.data(), SkinningMethod::BlendPositions);
+	MeasureArrays("  Arrays, Affine3x4, BlendMatrices", mesh, mesh.Affines.data(), SkinningMethod::BlendMatrices);
+	MeasureArrays("  Arrays, Affine3x4, BlendPositions", mesh, mesh.Affines.data(), SkinningMethod::BlendPositions);
+	MeasureStreams("  Streams, Matrix4x4, BlendMatrices", mesh, mesh.Matrices.data(), SkinningMethod::BlendMatrices);
+	MeasureStreams("  Streams, Matrix4x4, BlendPositions", mesh, mesh.Matrices.data(), SkinningMethod::BlendPositions);
+	MeasureStreams("  Streams, Affine3x4, BlendMatrices", mesh, mesh.Affines.data(), SkinningMethod::BlendMatrices);
+	MeasureStreams("  Streams, Affine3x4, BlendPositions", mesh, mesh.Affines.data(), SkinningMethod::BlendPositions);
+}
@@ -1,10 +1,23 @@
 #pragma once
 
+#include "Pargon/Math/Affine.h"
 #include "Pargon/Math/Angle.h"
 #include "Pargon/Math/Arithmetic.h"
+#include "Pargon/Math/Bounds.h"
+#include "Pargon/Math/Bvh.h"
+#include "Pargon/Math/DualQuaternion.h"
+#include "Pargon/Math/Frustum.h"
+#include "Pargon/Math/Hierarchy.h"
+#include "Pargon/Math/KdTree.h"
+#include "Pargon/Math/LooseTree.h"
 #include "Pargon/Math/Matrix.h"
 #include "Pargon/Math/Point.h"
 #include "Pargon/Math/Quaternion.h"
+#include "Pargon/Math/Ray.h"
 #include "Pargon/Math/Rotation.h"
+#include "Pargon/Math/Skinning.h"
+#include "Pargon/Math/SpatialHash.h"
+#include "Pargon/Math/Stream.h"
+#include "Pargon/Math/SweepAndPrune.h"
 #include "Pargon/Math/Trigonometry.h"
 #include "Pargon/Math/Vector.h"
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "Pargon/Containers/Array.h"
+#include "Pargon/Math/Point.h"
+#include "Pargon/Math/Rotation.h"
+#include "Pargon/Math/Vector.h"
+
+namespace Pargon
+{
+	class BufferReader;
+	class BufferWriter;
+	class Matrix3x3;
+	class Matrix4x4;
+	class StringReader;
+	class StringView;
+	class StringWriter;
+
+	// Each row holds one column of the equivalent Matrix3x3 or Matrix4x4 so a row produces one component of a
+	// transformed point. The implied last row is 0 0 1 (or 0 0 0 1) and is not stored. Multiplication composes in the
+	// same order as the equivalent matrix.
+	class Affine2x3
+	{
+	public:
+		static constexpr auto CreateIdentity() -> Affine2x3;
+		static constexpr auto CreateTranslation(Vector2 translation) -> Affine2x3;
+		static constexpr auto CreateScale(Vector2 scale) -> Affine2x3;
+		static auto CreateRotation(Rotation angle) -> Affine2x3;
+		static auto CreateTransform(Vector2 position, Vector2 scale, Rotation angle, Vector2 offset) -> Affine2x3;
+		static auto CreateFromMatrix(const Matrix3x3& matrix) -> Affine2x3;
+
+		constexpr Affine2x3() = default;
+		constexpr Affine2x3(float row1column1, float row1column2, float row1column3, float row2column1, float row2column2, float row2column3);
+
+		Array<float, 6> Elements;
+
+		auto operator==(const Affine2x3& right) const -> bool;
+		auto operator!=(const Affine2x3& right) const -> bool;
+		auto operator*=(const Affine2x3& right) -> Affine2x3&;
+		auto operator*(const Affine2x3& right) const -> Affine2x3;
+
+		auto Get(int row, int column) const -> float;
+		void Set(int row, int column, float value);
+
+		auto GetDeterminant() const -> float;
+		auto GetTranslation() const -> Vector2;
+		auto Get3x3() const -> Matrix3x3;
+
+		auto TransformPoint(Point2 point) const -> Point2;
+		auto TransformVector(Vector2 vector) const -> Vector2;
+
+		void Invert();
+		void Translate(Vector2 translation);
+		void Scale(Vector2 scale);
+		void Rotate(Rotation angle);
+
+		auto Inverted() const -> Affine2x3;
+		auto Translated(Vector2 translation) const -> Affine2x3;
+		auto Scaled(Vector2 scale) const -> Affine2x3;
+		auto Rotated(Rotation angle) const -> Affine2x3;
+
+		void ToBuffer(BufferWriter& writer) const;
+		void FromBuffer(BufferReader& reader);
+		void ToString(StringWriter& writer, StringView format) const;
+		void FromString(StringReader& reader, StringView format);
+	};
+
+	class alignas(16) Affine3x4
+	{
+	public:
+		static constexpr auto CreateIdentity() -> Affine3x4;
+		static auto CreateFromMatrix(const Matrix4x4& matrix) -> Affine3x4;
+
+		constexpr Affine3x4() = default;
+		constexpr Affine3x4(float row1column1, float row1column2, float row1column3, float row1column4, float row2column1, float row2column2, float row2column3, float row2column4, float row3column1, float row3column2, float row3column3, float row3column4);
+
+		Array<float, 12> Elements;
+
+		auto operator==(const Affine3x4& right) const -> bool;
+		auto operator!=(const Affine3x4& right) const -> bool;
+		auto operator*=(const Affine3x4& right) -> Affine3x4&;
+		auto operator*(const Affine3x4& right) const -> Affine3x4;
+
+		auto Get(int row, int column) const -> float;
+		void Set(int row, int column, float value);
+
+		auto GetDeterminant() const -> float;
+		auto GetTranslation() const -> Vector3;
+		auto Get4x4() const -> Matrix4x4;
+
+		auto TransformPoint(Point3 point) const -> Point3;
+		auto TransformVector(Vector3 vector) const -> Vector3;
+
+		void Invert();
+		auto Inverted() const -> Affine3x4;
+
+		void ToBuffer(BufferWriter& writer) const;
+		void FromBuffer(BufferReader& reader);
+		void ToString(StringWriter& writer, StringView format) const;
+		void FromString(StringReader& reader, StringView format);
+	};
+
+	void TransformPoints(const Point2* points, int count, const Affine2x3& transform, Point2* results);
+	void TransformVectors(const Vector2* vectors, int count, const Affine2x3& transform, Vector2* results);
+}
+
+constexpr
+auto Pargon::Affine2x3::CreateIdentity() -> Affine2x3
+{
+	return
+	{
+		1.0f, 0.0f, 0.0f,
+		0.0f, 1.0f, 0.0f
+	};
+}
+
+constexpr
+auto Pargon::Affine2x3::CreateTranslation(Vector2 translation) -> Affine2x3
+{
+	return
+	{
+		1.0f, 0.0f, translation.X,
+		0.0f, 1.0f, translation.Y
+	};
+}
+
+constexpr
+auto Pargon::Affine2x3::CreateScale(Vector2 scale) -> Affine2x3
+{
+	return
+	{
+		scale.X, 0.0f, 0.0f,
+		0.0f, scale.Y, 0.0f
+	};
+}
+
+constexpr
+Pargon::Affine2x3::Affine2x3(float row1column1, float row1column2, float row1column3, float row2column1, float row2column2, float row2column3) :
+	Elements{{ row1column1, row1column2, row1column3, row2column1, row2column2, row2column3 }}
+{
+}
+
+constexpr
+auto Pargon::Affine3x4::CreateIdentity() -> Affine3x4
+{
+	return
+	{
+		1.0f, 0.0f, 0.0f, 0.0f,
+		0.0f, 1.0f, 0.0f, 0.0f,
+		0.0f, 0.0f, 1.0f, 0.0f
+	};
+}
+
+constexpr
+Pargon::Affine3x4::Affine3x4(float row1column1, float row1column2, float row1column3, float row1column4, float row2column1, float row2column2, float row2column3, float row2column4, float row3column1, float row3column2, float row3column3, float row3column4) :
+	Elements{{ row1column1, row1column2, row1column3, row1column4, row2column1, row2column2, row2column3, row2column4, row3column1, row3column2, row3column3, row3column4 }}
+{
+}
@@ -0,0 +1,240 @@
+#pragma once
+
+#include "Pargon/Containers/Array.h"
+#include "Pargon/Math/Point.h"
+#include "Pargon/Math/Vector.h"
+
+#include <cstdint>
+#include <limits>
+
+namespace Pargon
+{
+	class BufferReader;
+	class BufferWriter;
+	class Matrix3x3;
+	class Matrix4x4;
+	class Point3Stream;
+	class StringReader;
+	class StringView;
+	class StringWriter;
+
+	// An empty box has its minimum above its maximum so merging anything into it gives the bounds of that thing, and
+	// transforming it leaves it empty. Transforms use Arvo's method so the result encloses the transformed box.
+	class Aabb2
+	{
+	public:
+		static constexpr auto CreateEmpty() -> Aabb2;
+		static auto CreateFromPoints(const Point2* points, int count) -> Aabb2;
+
+		Point2 Minimum;
+		Point2 Maximum;
+
+		constexpr auto operator==(const Aabb2& right) const -> bool;
+		constexpr auto operator!=(const Aabb2& right) const -> bool;
+
+		constexpr auto IsEmpty() const -> bool;
+		auto GetCenter() const -> Point2;
+		auto GetExtents() const -> Vector2;
+
+		auto Contains(Point2 point) const -> bool;
+		auto Contains(const Aabb2& bounds) const -> bool;
+		auto Overlaps(const Aabb2& bounds) const -> bool;
+
+		void Merge(Point2 point);
+		void Merge(const Aabb2& bounds);
+		void Transform(const Matrix3x3& transform);
+
+		auto Merged(Point2 point) const -> Aabb2;
+		auto Merged(const Aabb2& bounds) const -> Aabb2;
+		auto Transformed(const Matrix3x3& transform) const -> Aabb2;
+
+		void ToBuffer(BufferWriter& writer) const;
+		void FromBuffer(BufferReader& reader);
+		void ToString(StringWriter& writer, StringView format) const;
+		void FromString(StringReader& reader, StringView format);
+	};
+
+	class Aabb3
+	{
+	public:
+		static constexpr auto CreateEmpty() -> Aabb3;
+		static auto CreateFromPoints(const Point3* points, int count) -> Aabb3;
+		static auto CreateFromPoints(const Point3Stream& points) -> Aabb3;
+
+		Point3 Minimum;
+		Point3 Maximum;
+
+		constexpr auto operator==(const Aabb3& right) const -> bool;
+		constexpr auto operator!=(const Aabb3& right) const -> bool;
+
+		constexpr auto IsEmpty() const -> bool;
+		auto GetCenter() const -> Point3;
+		auto GetExtents() const -> Vector3;
+
+		auto Contains(Point3 point) const -> bool;
+		auto Contains(const Aabb3& bounds) const -> bool;
+		auto Overlaps(const Aabb3& bounds) const -> bool;
+
+		void Merge(Point3 point);
+		void Merge(const Aabb3& bounds);
+		void Transform(const Matrix4x4& transform);
+
+		auto Merged(Point3 point) const -> Aabb3;
+		auto Merged(const Aabb3& bounds) const -> Aabb3;
+		auto Transformed(const Matrix4x4& transform) const -> Aabb3;
+
+		void ToBuffer(BufferWriter& writer) const;
+		void FromBuffer(BufferReader& reader);
+		void ToString(StringWriter& writer, StringView format) const;
+		void FromString(StringReader& reader, StringView format);
+	};
+
+	// CreateFromPoints centers the sphere on the bounding box of the points and is not the minimal sphere. Transforms
+	// scale the radius by a bound on the largest stretch of the matrix, which is exact unless the matrix has shear.
+	class alignas(16) BoundingSphere
+	{
+	public:
+		static auto CreateFromPoints(const Point3* points, int count) -> BoundingSphere;
+		static auto CreateFromPoints(const Point3Stream& points) -> BoundingSphere;
+
+		Point3 Center;
+		float Radius;
+
+		constexpr auto operator==(const BoundingSphere& right) const -> bool;
+		constexpr auto operator!=(const BoundingSphere& right) const -> bool;
+
+		auto Contains(Point3 point) const -> bool;
+		auto Contains(const BoundingSphere& sphere) const -> bool;
+		auto Overlaps(const BoundingSphere& sphere) const -> bool;
+		auto Overlaps(const Aabb3& bounds) const -> bool;
+
+		void Merge(Point3 point);
+		void Merge(const BoundingSphere& sphere);
+		void Transform(const Matrix4x4& transform);
+
+		auto Merged(Point3 point) const -> BoundingSphere;
+		auto Merged(const BoundingSphere& sphere) const -> BoundingSphere;
+		auto Transformed(const Matrix4x4& transform) const -> BoundingSphere;
+
+		void ToBuffer(BufferWriter& writer) const;
+		void FromBuffer(BufferReader& reader);
+		void ToString(StringWriter& writer, StringView format) const;
+		void FromString(StringReader& reader, StringView format);
+	};
+
+	// Axes are unit length and form a right handed basis. CreateFromPoints orients the box along the principal
+	// components of the points. Merging keeps the orientation of this box and grows it to enclose the other, and a
+	// transform with shear orthogonalizes the transformed axes and grows the extents, so both can be loose.
+	class Obb
+	{
+	public:
+		static auto CreateFromPoints(const Point3* points, int count) -> Obb;
+		static auto CreateFromPoints(const Point3Stream& points) -> Obb;
+		static auto CreateFromAabb(const Aabb3& bounds, const Matrix4x4& transform) -> Obb;
+
+		Point3 Center;
+		Vector3 Extents;
+		Array<Vector3, 3> Axes;
+
+		auto GetBounds() const -> Aabb3;
+
+		auto Contains(Point3 point) const -> bool;
+		auto Overlaps(const Obb& box) const -> bool;
+
+		void Merge(Point3 point);
+		void Merge(const Obb& box);
+		void Transform(const Matrix4x4& transform);
+
+		auto Merged(Point3 point) const -> Obb;
+		auto Merged(const Obb& box) const -> Obb;
+		auto Transformed(const Matrix4x4& transform) const -> Obb;
+
+		void ToBuffer(BufferWriter& writer) const;
+		void FromBuffer(BufferReader& reader);
+		void ToString(StringWriter& writer, StringView format) const;
+		void FromString(StringReader& reader, StringView format);
+	};
+
+	// The batch transforms take either one transform for every bound or one transform per bound, which is the usual
+	// case when updating world bounds of moving objects. Overlap results are packed 32 bounds to a word so overlaps
+	// must hold at least (count + 31) / 32 entries.
+	void TransformBounds(const Aabb2* bounds, int count, const Matrix3x3& transform, Aabb2* results);
+	void TransformBounds(const Aabb2* bounds, const Matrix3x3* transforms, int count, Aabb2* results);
+	void TransformBounds(const Aabb3* bounds, int count, const Matrix4x4& transform, Aabb3* results);
+	void TransformBounds(const Aabb3* bounds, const Matrix4x4* transforms, int count, Aabb3* results);
+	void TransformBounds(const BoundingSphere* spheres, int count, const Matrix4x4& transform, BoundingSphere* results);
+	void TransformBounds(const BoundingSphere* spheres, const Matrix4x4* transforms, int count, BoundingSphere* results);
+	void TransformBounds(const Obb* boxes, int count, const Matrix4x4& transform, Obb* results);
+	void TransformBounds(const Obb* boxes, const Matrix4x4* transforms, int count, Obb* results);
+
+	auto MergeBounds(const Aabb2* bounds, int count) -> Aabb2;
+	auto MergeBounds(const Aabb3* bounds, int count) -> Aabb3;
+	auto MergeBounds(const BoundingSphere* spheres, int count) -> BoundingSphere;
+
+	void TestOverlaps(const Aabb2& bounds, const Aabb2* others, int count, std::uint32_t* overlaps);
+	void TestOverlaps(const Aabb3& bounds, const Aabb3* others, int count, std::uint32_t* overlaps);
+	void TestOverlaps(const BoundingSphere& sphere, const BoundingSphere* others, int count, std::uint32_t* overlaps);
+	void TestOverlaps(const Obb& box, const Obb* others, int count, std::uint32_t* overlaps);
+}
+
+constexpr
+auto Pargon::Aabb2::CreateEmpty() -> Aabb2
+{
+	constexpr auto infinity = std::numeric_limits<float>::infinity();
+	return { { infinity, infinity }, { -infinity, -infinity } };
+}
+
+constexpr
+auto Pargon::Aabb2::operator==(const Aabb2& right) const -> bool
+{
+	return Minimum == right.Minimum && Maximum == right.Maximum;
+}
+
+constexpr
+auto Pargon::Aabb2::operator!=(const Aabb2& right) const -> bool
+{
+	return !operator==(right);
+}
+
+constexpr
+auto Pargon::Aabb2::IsEmpty() const -> bool
+{
+	return Minimum.X > Maximum.X || Minimum.Y > Maximum.Y;
+}
+
+constexpr
+auto Pargon::Aabb3::CreateEmpty() -> Aabb3
+{
+	constexpr auto infinity = std::numeric_limits<float>::infinity();
+	return { { infinity, infinity, infinity }, { -infinity, -infinity, -infinity } };
+}
+
+constexpr
+auto Pargon::Aabb3::operator==(const Aabb3& right) const -> bool
+{
+	return Minimum == right.Minimum && Maximum == right.Maximum;
+}
+
+constexpr
+auto Pargon::Aabb3::operator!=(const Aabb3& right) const -> bool
+{
+	return !operator==(right);
+}
+
+constexpr
+auto Pargon::Aabb3::IsEmpty() const -> bool
+{
+	return Minimum.X > Maximum.X || Minimum.Y > Maximum.Y || Minimum.Z > Maximum.Z;
+}
+
+constexpr
+auto Pargon::BoundingSphere::operator==(const BoundingSphere& right) const -> bool
+{
+	return Center == right.Center && Radius == right.Radius;
+}
+
+constexpr
+auto Pargon::BoundingSphere::operator!=(const BoundingSphere& right) const -> bool
+{
+	return !operator==(right);
+}
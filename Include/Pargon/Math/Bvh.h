@@ -0,0 +1,106 @@
+#pragma once
+
+#include "Pargon/Math/Bounds.h"
+#include "Pargon/Math/Point.h"
+#include "Pargon/Math/Vector.h"
+
+#include <memory>
+
+namespace Pargon
+{
+	class BufferReader;
+	class BufferWriter;
+
+	// A bounding volume hierarchy over primitive bounds built with binned SAH. Nodes are stored depth first so the first
+	// child of an interior node immediately follows it and Offset holds the second, while leaves hold Count primitive
+	// indices starting at Offset. Building can be split across threads the same way as TransformHierarchy::Update:
+	// BeginBuild splits the top of the tree, each task builds one subtree, and EndBuild links them. Leaves hold at most
+	// leafSize primitives. Collapse adds 4 or 8 wide nodes that queries use in place of the binary
+	// nodes so each step tests several children at once.
+	class Bvh
+	{
+	public:
+		struct Node
+		{
+			Aabb3 Bounds;
+			int Offset;
+			int Count;
+		};
+
+		// A child with Count 0 is an interior node at index Child, a positive Count is a leaf, and unused slots have a
+		// Count of -1 and empty bounds.
+		template<int Width>
+		struct WideNode
+		{
+			float MinimumX[Width];
+			float MinimumY[Width];
+			float MinimumZ[Width];
+			float MaximumX[Width];
+			float MaximumY[Width];
+			float MaximumZ[Width];
+			int Child[Width];
+			int Count[Width];
+		};
+
+		static constexpr int DefaultLeafSize = 4;
+		static constexpr int DefaultTaskCount = 64;
+
+		Bvh();
+		Bvh(const Bvh& copy);
+		Bvh(Bvh&& move) noexcept;
+		~Bvh();
+
+		auto operator=(const Bvh& copy) -> Bvh&;
+		auto operator=(Bvh&& move) noexcept -> Bvh&;
+
+		auto GetNodeCount() const -> int;
+		auto GetNodes() const -> const Node*;
+		auto GetIndexCount() const -> int;
+		auto GetIndices() const -> const int*;
+		auto GetWidth() const -> int;
+		auto GetBounds() const -> Aabb3;
+
+		void Build(const Aabb3* bounds, int count, int leafSize = DefaultLeafSize);
+
+		void BeginBuild(const Aabb3* bounds, int count, int leafSize = DefaultLeafSize, int taskCount = DefaultTaskCount);
+		auto GetTaskCount() const -> int;
+		void BuildTask(int task);
+		void EndBuild();
+
+		void Collapse(int width);
+
+		// Finds the primitives of every leaf the bounds overlap, which can include primitives that do not overlap, and
+		// returns how many there are. Only the first capacity of them are written, so a result larger than capacity
+		// means the query should be repeated with more room. GetIndexCount is always enough.
+		auto Query(const Aabb3& bounds, int* primitives, int capacity) const -> int;
+
+		// intersect(primitive, distance) is called for each primitive whose bounds the ray reaches within distance and
+		// should return true and shorten distance when it finds a closer hit. The closest primitive is returned, or -1
+		// if nothing was hit, and distance is left at the closest hit.
+		template<typename Intersect>
+		auto Raycast(Point3 origin, Vector3 direction, float& distance, Intersect intersect) const -> int;
+
+		// FromBuffer leaves the tree empty if the buffer does not hold a valid tree.
+		void ToBuffer(BufferWriter& writer) const;
+		void FromBuffer(BufferReader& reader);
+
+	private:
+		using IntersectFunction = bool (*)(void* context, int primitive, float& distance);
+
+		struct Data;
+		std::unique_ptr<Data> _data;
+
+		auto RaycastNodes(Point3 origin, Vector3 direction, float& distance, IntersectFunction intersect, void* context) const -> int;
+	};
+}
+
+template<typename Intersect>
+auto Pargon::Bvh::Raycast(Point3 origin, Vector3 direction, float& distance, Intersect intersect) const -> int
+{
+	auto function = [](void* context, int primitive, float& distance) -> bool
+	{
+		return (*static_cast<Intersect*>(context))(primitive, distance);
+	};
+
+	return RaycastNodes(origin, direction, distance, function, &intersect);
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "Pargon/Math/Matrix.h"
+#include "Pargon/Math/Point.h"
+#include "Pargon/Math/Quaternion.h"
+#include "Pargon/Math/Vector.h"
+
+namespace Pargon
+{
+	class BufferReader;
+	class BufferWriter;
+	class StringReader;
+	class StringView;
+	class StringWriter;
+
+	// A rigid transform that rotates by Real and then translates. Scale is not representable and is dropped when
+	// converting from a matrix or Matrix4x4::Transform. Multiplication composes in the same order as Matrix4x4.
+	class alignas(16) DualQuaternion
+	{
+	public:
+		static constexpr auto CreateIdentity() -> DualQuaternion;
+		static constexpr auto CreateRotation(Quaternion rotation) -> DualQuaternion;
+		static auto CreateTranslation(Vector3 translation) -> DualQuaternion;
+		static auto CreateTransform(Vector3 translation, Quaternion rotation) -> DualQuaternion;
+		static auto CreateFromTransform(const Matrix4x4::Transform& transform) -> DualQuaternion;
+		static auto CreateFromMatrix(const Matrix4x4& matrix) -> DualQuaternion;
+
+		Quaternion Real;
+		Quaternion Dual;
+
+		constexpr auto operator==(const DualQuaternion& right) const -> bool;
+		constexpr auto operator!=(const DualQuaternion& right) const -> bool;
+
+		auto operator*=(const DualQuaternion& right) -> DualQuaternion&;
+		auto operator*(const DualQuaternion& right) const -> DualQuaternion;
+
+		auto GetRotation() const -> Quaternion;
+		auto GetTranslation() const -> Vector3;
+		auto GetTransform() const -> Matrix4x4::Transform;
+		auto Get4x4() const -> Matrix4x4;
+
+		auto TransformPoint(Point3 point) const -> Point3;
+		auto TransformVector(Vector3 vector) const -> Vector3;
+
+		void Normalize();
+		void Invert();
+
+		auto Normalized() const -> DualQuaternion;
+		auto Inverted() const -> DualQuaternion;
+
+		void ToBuffer(BufferWriter& writer) const;
+		void FromBuffer(BufferReader& reader);
+		void ToString(StringWriter& writer, StringView format) const;
+		void FromString(StringReader& reader, StringView format);
+	};
+
+	// Dual quaternion linear blending: weights are applied after flipping each transform into the same hemisphere as
+	// the first and the sum is renormalized, so blended results stay rigid.
+	void BlendDualQuaternions(const DualQuaternion* transforms, const float* weights, int count, DualQuaternion& result);
+}
+
+constexpr
+auto Pargon::DualQuaternion::CreateIdentity() -> DualQuaternion
+{
+	return { Quaternion::CreateIdentity(), { 0.0f, 0.0f, 0.0f, 0.0f } };
+}
+
+constexpr
+auto Pargon::DualQuaternion::CreateRotation(Quaternion rotation) -> DualQuaternion
+{
+	return { rotation, { 0.0f, 0.0f, 0.0f, 0.0f } };
+}
+
+constexpr
+auto Pargon::DualQuaternion::operator==(const DualQuaternion& right) const -> bool
+{
+	return Real == right.Real && Dual == right.Dual;
+}
+
+constexpr
+auto Pargon::DualQuaternion::operator!=(const DualQuaternion& right) const -> bool
+{
+	return !operator==(right);
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Pargon/Containers/Array.h"
+#include "Pargon/Math/Point.h"
+#include "Pargon/Math/Vector.h"
+
+#include <cstdint>
+
+namespace Pargon
+{
+	class FloatStream;
+	class Matrix4x4;
+	class Point3Stream;
+	class Vector3Stream;
+
+	// Planes are normalized with their normals pointing into the frustum and are stored in the order left, right,
+	// bottom, top, near, far. The matrix is expected to use the clip volume of CreatePerspectiveProjection and
+	// CreateOrthographicProjection (0 <= z <= w) and can include a model and view transform to cull in that space.
+	class Frustum
+	{
+	public:
+		struct Plane
+		{
+			Vector3 Normal;
+			float Distance;
+		};
+
+		static constexpr int PlaneCount = 6;
+
+		static auto CreateFromMatrix(const Matrix4x4& viewProjection) -> Frustum;
+
+		Array<Plane, PlaneCount> Planes;
+
+		auto Contains(Point3 point) const -> bool;
+		auto IntersectsSphere(Point3 center, float radius) const -> bool;
+		auto IntersectsBox(Point3 center, Vector3 extents) const -> bool;
+
+		// Bounds are tested against each plane separately so a large bound just outside a corner of the frustum can be
+		// reported as visible. The bitmask overloads pack 32 bounds to a word so visibility must hold at least
+		// (count + 31) / 32 entries. The index overloads write the indices of the visible bounds in order to visible,
+		// which must have room for every bound, and return how many were written.
+		void CullSpheres(const Point3Stream& centers, const FloatStream& radii, std::uint32_t* visibility) const;
+		auto CullSpheres(const Point3Stream& centers, const FloatStream& radii, int* visible) const -> int;
+		void CullBoxes(const Point3Stream& centers, const Vector3Stream& extents, std::uint32_t* visibility) const;
+		auto CullBoxes(const Point3Stream& centers, const Vector3Stream& extents, int* visible) const -> int;
+	};
+}
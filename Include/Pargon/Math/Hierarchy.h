@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Pargon/Math/Matrix.h"
+#include "Pargon/Math/Quaternion.h"
+#include "Pargon/Math/Vector.h"
+
+#include <memory>
+
+namespace Pargon
+{
+	// Nodes are identified by stable handles but stored sorted by depth with siblings next to each other, so every
+	// parent is updated before its children and a level can be split into chunks that update independently. Adding,
+	// removing and reparenting nodes is deferred until the next update. Removing a node also removes its descendants.
+	class TransformHierarchy
+	{
+	public:
+		static constexpr int InvalidNode = -1;
+		static constexpr int DefaultChunkSize = 2048;
+
+		explicit TransformHierarchy(int chunkSize = DefaultChunkSize);
+		TransformHierarchy(const TransformHierarchy& copy);
+		TransformHierarchy(TransformHierarchy&& move) noexcept;
+		~TransformHierarchy();
+
+		auto operator=(const TransformHierarchy& copy) -> TransformHierarchy&;
+		auto operator=(TransformHierarchy&& move) noexcept -> TransformHierarchy&;
+
+		auto Count() const -> int;
+		auto IsValid(int node) const -> bool;
+
+		auto AddNode(int parent = InvalidNode) -> int;
+		auto AddNode(int parent, const Matrix4x4::Transform& local) -> int;
+		void RemoveNode(int node);
+		void SetParent(int node, int parent);
+		auto GetParent(int node) const -> int;
+
+		auto GetLocalTransform(int node) const -> Matrix4x4::Transform;
+		void SetLocalTransform(int node, const Matrix4x4::Transform& local);
+		void SetTranslation(int node, Vector3 translation);
+		void SetScale(int node, Vector3 scale);
+		void SetRotation(int node, Quaternion rotation);
+		auto GetWorldMatrix(int node) const -> const Matrix4x4&;
+
+		void Update();
+
+		void BeginUpdate();
+		auto GetLevelCount() const -> int;
+		auto GetChunkCount(int level) const -> int;
+		void UpdateChunk(int level, int chunk);
+		void EndUpdate();
+
+	private:
+		struct Data;
+		std::unique_ptr<Data> _data;
+		int _chunkSize;
+		bool _structureChanged = false;
+
+		void MarkDirty(int node);
+	};
+}
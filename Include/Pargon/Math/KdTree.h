@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Pargon/Math/Point.h"
+
+#include <memory>
+
+namespace Pargon
+{
+	// The tree is implicit in the order of its points: the median of each range is the node that splits it, and the
+	// points before and after it are its two subtrees, so the only other storage is the split axis of each node. Ranges
+	// of LeafSize points or fewer are searched directly. Building can be split across threads the same way as
+	// TransformHierarchy::Update: after BeginBuild each task of a stage can run in parallel, but every task of a stage
+	// must finish before the next stage starts. Queries are const so batches can be split across threads by range.
+	//
+	// A nonzero epsilon allows an approximate search that can return a point up to (1 + epsilon) times farther than the
+	// true nearest point, in exchange for visiting fewer nodes.
+	class KdTree
+	{
+	public:
+		static constexpr int LeafSize = 8;
+		static constexpr int DefaultTaskCount = 64;
+
+		KdTree();
+		KdTree(const KdTree& copy);
+		KdTree(KdTree&& move) noexcept;
+		~KdTree();
+
+		auto operator=(const KdTree& copy) -> KdTree&;
+		auto operator=(KdTree&& move) noexcept -> KdTree&;
+
+		auto Count() const -> int;
+
+		void Build(const Point3* points, int count);
+
+		void BeginBuild(const Point3* points, int count, int taskCount = DefaultTaskCount);
+		auto GetStageCount() const -> int;
+		auto GetTaskCount(int stage) const -> int;
+		void BuildTask(int stage, int task);
+		void EndBuild();
+
+		// Results are indices into the points the tree was built from. Nearest returns -1 for an empty tree. The k
+		// nearest fill k entries per point ordered nearest first with -1 past the end, and the single point form returns
+		// how many were found. The radius queries return how many results they found but only write the first capacity
+		// of them, so a result larger than capacity means the query should be repeated with more room. The batch radius
+		// query places the results of point i in the range [offsets[i], offsets[i + 1]), so offsets must hold count + 1
+		// entries.
+		auto FindNearest(Point3 point, float epsilon = 0.0f) const -> int;
+		auto FindNearest(Point3 point, int k, int* results, float epsilon = 0.0f) const -> int;
+		auto FindInRadius(Point3 point, float radius, int* results, int capacity) const -> int;
+
+		void FindNearest(const Point3* points, int count, int* results, float epsilon = 0.0f) const;
+		void FindNearest(const Point3* points, int count, int k, int* results, float epsilon = 0.0f) const;
+		auto FindInRadius(const Point3* points, int count, float radius, int* results, int capacity, int* offsets) const -> int;
+
+	private:
+		struct Data;
+		std::unique_ptr<Data> _data;
+		int _splitStages = 0;
+
+		void GetRange(int depth, int node, int& start, int& end) const;
+	};
+}
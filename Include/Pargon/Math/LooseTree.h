@@ -0,0 +1,105 @@
+#pragma once
+
+#include "Pargon/Math/Bounds.h"
+#include "Pargon/Math/Point.h"
+
+#include <atomic>
+#include <memory>
+
+namespace Pargon
+{
+	class Frustum;
+
+	// A loose tree stores each object in the deepest node that contains its center and whose cell is at least the size
+	// of the object. A node's loose bounds are its cell grown by half a cell on every side, so they are twice the size
+	// of the cell and always hold the objects stored in it. An object that moves but stays inside its node's loose
+	// bounds only has its bounds updated, and anything else is unlinked and relinked in place. Nodes and objects come
+	// from pools that are reused as they are freed. Objects outside the world bounds are kept in the root.
+	//
+	// The tree is kept twice so one writer can update while any number of readers query without locking. Insert, Move
+	// and Remove change the copy readers cannot see, and Publish swaps the copies and then replays the changes on the
+	// other copy once the last reader has left it. Readers see the state as of the last Publish and never wait. The
+	// writer functions must only be called from one thread at a time.
+	template<typename BoundsType>
+	class LooseTree
+	{
+	public:
+		using PointType = decltype(BoundsType::Minimum);
+
+		static constexpr int InvalidObject = -1;
+		static constexpr int DefaultMaximumDepth = 8;
+
+		explicit LooseTree(const BoundsType& world, int maximumDepth = DefaultMaximumDepth);
+		LooseTree(const LooseTree& copy) = delete;
+		~LooseTree();
+
+		auto operator=(const LooseTree& copy) -> LooseTree& = delete;
+
+		auto Insert(const BoundsType& bounds) -> int;
+		void Move(int object, const BoundsType& bounds);
+		void Remove(int object);
+		void Publish();
+
+		// Queries return how many results they found but only write the first capacity of them, so a result larger than
+		// capacity means the query should be repeated with more room. The batch queries place the results of query i in
+		// the range [offsets[i], offsets[i + 1]), so offsets must hold count + 1 entries.
+		auto Count() const -> int;
+		auto QueryBox(const BoundsType& bounds, int* results, int capacity) const -> int;
+		auto QueryBoxes(const BoundsType* bounds, int count, int* results, int capacity, int* offsets) const -> int;
+		auto QuerySphere(PointType center, float radius, int* results, int capacity) const -> int;
+		auto QuerySpheres(const PointType* centers, const float* radii, int count, int* results, int capacity, int* offsets) const -> int;
+
+	protected:
+		static constexpr int Dimensions = sizeof(PointType) / sizeof(float);
+		static constexpr int ChildCount = 1 << Dimensions;
+
+		struct Tree;
+
+		template<typename Read> void ReadFront(Read read) const;
+		template<typename NodeTest, typename ObjectTest> static void Visit(const Tree& tree, NodeTest nodeTest, ObjectTest objectTest, int* results, int capacity, int& total);
+
+	private:
+		struct Change;
+		struct Data;
+
+		PointType _origin;
+		float _size;
+		int _maximumDepth;
+
+		std::unique_ptr<Data> _data;
+		std::atomic<int> _front;
+		std::atomic<int> _version;
+		mutable std::atomic<int> _readers[2];
+
+		auto GetBack() -> Tree&;
+		void Apply(Tree& tree, const Change& change);
+
+		auto InsertObject(Tree& tree, const BoundsType& bounds) -> int;
+		void MoveObject(Tree& tree, int object, const BoundsType& bounds);
+		void RemoveObject(Tree& tree, int object);
+
+		auto FindNode(Tree& tree, const BoundsType& bounds) -> int;
+		auto AllocateNode(Tree& tree, int parent, const BoundsType& bounds) -> int;
+		void Link(Tree& tree, int object, int node);
+		void Unlink(Tree& tree, int object);
+		void Prune(Tree& tree, int node);
+	};
+
+	class Quadtree : public LooseTree<Aabb2>
+	{
+	public:
+		using LooseTree::LooseTree;
+	};
+
+	class Octree : public LooseTree<Aabb3>
+	{
+	public:
+		using LooseTree::LooseTree;
+
+		auto QueryFrustum(const Frustum& frustum, int* results, int capacity) const -> int;
+		auto QueryFrustums(const Frustum* frustums, int count, int* results, int capacity, int* offsets) const -> int;
+	};
+
+	extern template class LooseTree<Aabb2>;
+	extern template class LooseTree<Aabb3>;
+}
@@ -15,6 +15,14 @@ namespace Pargon
 	class StringReader;
 	class StringWriter;
 
+	// RemoveShear orthogonalizes the basis so the rotation is always valid and a reflection shows up as a negative Z
+	// scale. AssumeNoShear only normalizes each row and is cheaper when the matrix is known to be built from TRS parts.
+	enum class TransformDecomposition
+	{
+		RemoveShear,
+		AssumeNoShear
+	};
+
 	class Matrix3x3
 	{
 	public:
@@ -100,21 +108,24 @@ namespace Pargon
 		auto Get(int row, int column) const -> float;
 		void Set(int row, int column, float value);
 
+		auto IsAffine() const -> bool;
 		auto GetDeterminant() const -> float;
 		auto GetTranslation() const -> Vector3;
-		auto GetScale() const -> Vector3;
-		auto GetRotation() const -> Quaternion;
-		auto GetTransform() const -> Transform;
+		auto GetScale(TransformDecomposition decomposition = TransformDecomposition::RemoveShear) const -> Vector3;
+		auto GetRotation(TransformDecomposition decomposition = TransformDecomposition::RemoveShear) const -> Quaternion;
+		auto GetTransform(TransformDecomposition decomposition = TransformDecomposition::RemoveShear) const -> Transform;
 		auto Get3x3() const -> Matrix3x3;
 
 		void Transpose();
 		void Invert();
+		void InvertAffine();
 		void Translate(Vector3 translation);
 		void Scale(Vector3 scale);
 		void Rotate(Quaternion rotation);
 
 		auto Transposed() const -> Matrix4x4;
 		auto Inverted() const -> Matrix4x4;
+		auto InvertedAffine() const -> Matrix4x4;
 		auto Translated(Vector3 translation) const -> Matrix4x4;
 		auto Scaled(Vector3 scale) const -> Matrix4x4;
 		auto Rotated(Quaternion rotation) const -> Matrix4x4;
@@ -124,6 +135,10 @@ namespace Pargon
 		void ToString(StringWriter& writer, StringView format) const;
 		void FromString(StringReader& reader, StringView format);
 	};
+
+	void BuildTransforms(const Vector2* translations, const Vector2* scales, const Rotation* rotations, int count, Matrix3x3* results);
+	void BuildTransforms(const Vector3* translations, const Vector3* scales, const Quaternion* rotations, int count, Matrix4x4* results);
+	void DecomposeTransforms(const Matrix4x4* matrices, int count, Matrix4x4::Transform* results, TransformDecomposition decomposition = TransformDecomposition::RemoveShear);
 }
 
 constexpr
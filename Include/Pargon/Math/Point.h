@@ -2,12 +2,15 @@
 
 #include "Pargon/Math/Vector.h"
 
+#include <cstdint>
+
 namespace Pargon
 {
 	class BufferReader;
 	class BufferWriter;
 	class Matrix3x3;
 	class Matrix4x4;
+	class Point3Stream;
 	class StringReader;
 	class StringView;
 	class StringWriter;
@@ -68,6 +71,11 @@ namespace Pargon
 		void ToString(StringWriter& writer, StringView format) const;
 		void FromString(StringReader& reader, StringView format);
 	};
+
+	void TransformPoints(const Point2* points, int count, const Matrix3x3& transform, Point2* results);
+	void TransformPoints(const Point3* points, int count, const Matrix4x4& transform, Point3* results);
+	void TransformPoints(const Point3Stream& points, const Matrix4x4& transform, Point3Stream& results);
+	void ProjectPoints(const Point3* points, int count, const Matrix4x4& projection, Point3* results, float* clipW = nullptr, std::uint32_t* visibility = nullptr);
 }
 
 constexpr
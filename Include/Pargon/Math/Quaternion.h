@@ -7,7 +7,9 @@ namespace Pargon
 {
 	class BufferReader;
 	class BufferWriter;
+	class FloatStream;
 	class Matrix4x4;
+	class QuaternionStream;
 	class Rotation;
 	class StringReader;
 	class StringView;
@@ -67,6 +69,21 @@ namespace Pargon
 		void ToString(StringWriter& writer, StringView format) const;
 		void FromString(StringReader& reader, StringView format);
 	};
+
+	enum class QuaternionInterpolation
+	{
+		Slerp,
+		Nlerp,
+		ApproximateSlerp
+	};
+
+	void MultiplyQuaternions(const Quaternion* left, const Quaternion* right, int count, Quaternion* results, bool normalize = true);
+	void NormalizeQuaternions(Quaternion* quaternions, int count);
+
+	// ApproximateSlerp replaces acos and sin with a fitted polynomial and stays within 4e-5 of exact slerp
+	// per component for unit inputs. Nlerp is cheaper still but does not keep a constant angular velocity.
+	void InterpolateQuaternions(const Quaternion* from, const Quaternion* to, const float* times, int count, Quaternion* results, QuaternionInterpolation mode = QuaternionInterpolation::Slerp);
+	void InterpolateQuaternions(const QuaternionStream& from, const QuaternionStream& to, const FloatStream& times, QuaternionStream& results, QuaternionInterpolation mode = QuaternionInterpolation::Slerp);
 }
 
 constexpr
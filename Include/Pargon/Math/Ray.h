@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Pargon/Math/Point.h"
+#include "Pargon/Math/Vector.h"
+
+#include <cstdint>
+
+namespace Pargon
+{
+	class Aabb3;
+	class BufferReader;
+	class BufferWriter;
+	class FloatStream;
+	class Matrix4x4;
+	class Point3Stream;
+	class StringReader;
+	class StringView;
+	class StringWriter;
+	class Vector3Stream;
+
+	// Direction does not have to be unit length, in which case distances along the ray are in multiples of its length.
+	// This keeps distances meaningful when a ray is transformed into the local space of a scaled object.
+	class Ray3
+	{
+	public:
+		// position is in pixels with y increasing upward, so window coordinates that increase downward must be flipped
+		// first. The ray starts on the near plane rather than at the camera so orthographic projections work, and its
+		// direction is unit length.
+		static auto CreatePickRay(Point2 position, Point2 viewportPosition, Vector2 viewportSize, const Matrix4x4& view, const Matrix4x4& projection) -> Ray3;
+
+		Point3 Origin;
+		Vector3 Direction;
+
+		constexpr auto operator==(const Ray3& right) const -> bool;
+		constexpr auto operator!=(const Ray3& right) const -> bool;
+
+		constexpr auto GetPoint(float distance) const -> Point3;
+
+		// distance is the farthest hit to accept and is set to the distance of the hit when true is returned. A ray
+		// starting inside a box hits it at 0 and triangles are hit from either side.
+		auto IntersectBox(const Aabb3& bounds, float& distance) const -> bool;
+		auto IntersectTriangle(Point3 a, Point3 b, Point3 c, float& distance) const -> bool;
+
+		void Transform(const Matrix4x4& transform);
+		auto Transformed(const Matrix4x4& transform) const -> Ray3;
+
+		void ToBuffer(BufferWriter& writer) const;
+		void FromBuffer(BufferReader& reader);
+		void ToString(StringWriter& writer, StringView format) const;
+		void FromString(StringReader& reader, StringView format);
+	};
+
+	// The packet functions test a stream of rays against one box or triangle with the same rules as the Ray3 methods.
+	// distances is shortened for each ray that hits and hits packs 32 rays to a word so it must hold at least
+	// (count + 31) / 32 entries. Calling these for each triangle of a mesh in turn leaves the closest hit in distances.
+	void IntersectRays(const Point3Stream& origins, const Vector3Stream& directions, const Aabb3& bounds, FloatStream& distances, std::uint32_t* hits);
+	void IntersectRays(const Point3Stream& origins, const Vector3Stream& directions, Point3 a, Point3 b, Point3 c, FloatStream& distances, std::uint32_t* hits);
+}
+
+constexpr
+auto Pargon::Ray3::operator==(const Ray3& right) const -> bool
+{
+	return Origin == right.Origin && Direction == right.Direction;
+}
+
+constexpr
+auto Pargon::Ray3::operator!=(const Ray3& right) const -> bool
+{
+	return !operator==(right);
+}
+
+constexpr
+auto Pargon::Ray3::GetPoint(float distance) const -> Point3
+{
+	return Origin + Direction * distance;
+}
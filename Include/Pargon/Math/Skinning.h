@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Pargon/Math/Vector.h"
+
+#include <cstdint>
+
+namespace Pargon
+{
+	class Affine3x4;
+	class DualQuaternion;
+	class Matrix4x4;
+	class Vector3Stream;
+
+	enum class SkinningMethod
+	{
+		BlendMatrices,
+		BlendPositions
+	};
+
+	// Vertex i reads influences (at most 8) bone indices and weights starting at bones[i * influences] and
+	// weights[i * influences], and the weights are expected to sum to one. Normals are transformed without translation
+	// and renormalized, and are skipped when null or empty. Vertex ranges are independent so a mesh can be split into
+	// chunks that are skinned on separate threads.
+	void SkinVertices(const Vector3* positions, const Vector3* normals, int count, const std::uint16_t* bones, const float* weights, int influences, const Matrix4x4* palette, Vector3* skinnedPositions, Vector3* skinnedNormals, SkinningMethod method = SkinningMethod::BlendMatrices);
+	void SkinVertices(const Vector3* positions, const Vector3* normals, int count, const std::uint16_t* bones, const float* weights, int influences, const Affine3x4* palette, Vector3* skinnedPositions, Vector3* skinnedNormals, SkinningMethod method = SkinningMethod::BlendMatrices);
+	void SkinVertices(const Vector3Stream& positions, const Vector3Stream& normals, int start, int count, const std::uint16_t* bones, const float* weights, int influences, const Matrix4x4* palette, Vector3Stream& skinnedPositions, Vector3Stream& skinnedNormals, SkinningMethod method = SkinningMethod::BlendMatrices);
+	void SkinVertices(const Vector3Stream& positions, const Vector3Stream& normals, int start, int count, const std::uint16_t* bones, const float* weights, int influences, const Affine3x4* palette, Vector3Stream& skinnedPositions, Vector3Stream& skinnedNormals, SkinningMethod method = SkinningMethod::BlendMatrices);
+
+	// Dual quaternion palettes are blended with dual quaternion linear blending, which keeps the result rigid and avoids
+	// the volume loss of blended matrices. Normals are only rotated.
+	void SkinVertices(const Vector3* positions, const Vector3* normals, int count, const std::uint16_t* bones, const float* weights, int influences, const DualQuaternion* palette, Vector3* skinnedPositions, Vector3* skinnedNormals);
+	void SkinVertices(const Vector3Stream& positions, const Vector3Stream& normals, int start, int count, const std::uint16_t* bones, const float* weights, int influences, const DualQuaternion* palette, Vector3Stream& skinnedPositions, Vector3Stream& skinnedNormals);
+}
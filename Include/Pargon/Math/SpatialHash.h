@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Pargon/Math/Point.h"
+
+#include <memory>
+
+namespace Pargon
+{
+	// Points are counting sorted into hashed cells on every build so the grid makes no per cell allocations and reuses
+	// its storage from frame to frame. Cells that hash to the same bucket share it. Building can be split across
+	// threads the same way as TransformHierarchy::Update: after BeginBuild each task of a stage can run in parallel,
+	// but every task of a stage must finish before the next stage starts. Queries are const so any number can run at
+	// once, and FindPairs can be split into tasks that each report a separate set of pairs. A radius larger than the
+	// cell size is supported but visits more cells, so the cell size is best set near the usual query radius.
+	template<typename PointType>
+	class SpatialHashGrid
+	{
+	public:
+		struct Pair
+		{
+			int First;
+			int Second;
+		};
+
+		static constexpr int BuildStageCount = 3;
+		static constexpr int DefaultTaskCount = 64;
+
+		explicit SpatialHashGrid(float cellSize, int taskCount = DefaultTaskCount);
+		SpatialHashGrid(const SpatialHashGrid& copy);
+		SpatialHashGrid(SpatialHashGrid&& move) noexcept;
+		~SpatialHashGrid();
+
+		auto operator=(const SpatialHashGrid& copy) -> SpatialHashGrid&;
+		auto operator=(SpatialHashGrid&& move) noexcept -> SpatialHashGrid&;
+
+		auto GetCellSize() const -> float;
+		auto GetTaskCount() const -> int;
+		auto Count() const -> int;
+
+		void Build(const PointType* points, int count);
+
+		void BeginBuild(const PointType* points, int count);
+		void BuildTask(int stage, int task);
+		void EndBuild();
+
+		// Results are indices into the points the grid was built from, in no particular order. Pairs are reported once
+		// with First less than Second. Each query returns how many results it found but only writes the first capacity
+		// of them, so a result larger than capacity means the query should be repeated with more room.
+		auto Query(PointType center, float radius, int* results, int capacity) const -> int;
+		auto FindPairs(float radius, Pair* pairs, int capacity) const -> int;
+		auto FindPairs(float radius, int task, Pair* pairs, int capacity) const -> int;
+
+	private:
+		float _cellSize;
+		float _inverseCellSize;
+		int _taskCount;
+		int _bucketBits = 0;
+
+		const PointType* _buildPoints = nullptr;
+		int _buildCount = 0;
+
+		struct Data;
+		std::unique_ptr<Data> _data;
+
+		auto GetBlockStart(int block) const -> int;
+		auto FindPairs(float radius, int start, int end, Pair* pairs, int capacity) const -> int;
+	};
+
+	using SpatialHashGrid2 = SpatialHashGrid<Point2>;
+	using SpatialHashGrid3 = SpatialHashGrid<Point3>;
+
+	extern template class SpatialHashGrid<Point2>;
+	extern template class SpatialHashGrid<Point3>;
+}
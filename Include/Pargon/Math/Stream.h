@@ -0,0 +1,207 @@
+#pragma once
+
+#include "Pargon/Math/Point.h"
+#include "Pargon/Math/Quaternion.h"
+#include "Pargon/Math/Vector.h"
+
+namespace Pargon
+{
+	class FloatStream
+	{
+	public:
+		static constexpr int Alignment = 32;
+		static constexpr int Padding = 8;
+
+		FloatStream() = default;
+		explicit FloatStream(int count);
+		FloatStream(const float* values, int count);
+		FloatStream(const FloatStream& copy);
+		FloatStream(FloatStream&& move) noexcept;
+		~FloatStream();
+
+		auto operator=(const FloatStream& copy) -> FloatStream&;
+		auto operator=(FloatStream&& move) noexcept -> FloatStream&;
+
+		auto Count() const -> int;
+		auto PaddedCount() const -> int;
+		auto Data() -> float*;
+		auto Data() const -> const float*;
+		auto Item(int index) -> float&;
+		auto Item(int index) const -> float;
+
+		void SetCount(int count);
+		void Add(float value);
+		void CopyTo(float* values) const;
+
+	private:
+		float* _data = nullptr;
+		int _count = 0;
+		int _capacity = 0;
+
+		void Reserve(int capacity);
+	};
+
+	class Vector2Stream
+	{
+	public:
+		class Reference
+		{
+		public:
+			float& X;
+			float& Y;
+
+			operator Vector2() const;
+			auto operator=(Vector2 vector) -> Reference&;
+			auto operator=(const Reference& reference) -> Reference&;
+		};
+
+		Vector2Stream() = default;
+		explicit Vector2Stream(int count);
+		Vector2Stream(const Vector2* vectors, int count);
+
+		auto Count() const -> int;
+		auto PaddedCount() const -> int;
+		auto GetX() -> float*;
+		auto GetX() const -> const float*;
+		auto GetY() -> float*;
+		auto GetY() const -> const float*;
+		auto Item(int index) -> Reference;
+		auto Item(int index) const -> Vector2;
+
+		void SetCount(int count);
+		void Add(Vector2 vector);
+		void CopyFrom(const Vector2* vectors, int count);
+		void CopyTo(Vector2* vectors) const;
+
+	private:
+		FloatStream _x;
+		FloatStream _y;
+	};
+
+	class Vector3Stream
+	{
+	public:
+		class Reference
+		{
+		public:
+			float& X;
+			float& Y;
+			float& Z;
+
+			operator Vector3() const;
+			auto operator=(Vector3 vector) -> Reference&;
+			auto operator=(const Reference& reference) -> Reference&;
+		};
+
+		Vector3Stream() = default;
+		explicit Vector3Stream(int count);
+		Vector3Stream(const Vector3* vectors, int count);
+
+		auto Count() const -> int;
+		auto PaddedCount() const -> int;
+		auto GetX() -> float*;
+		auto GetX() const -> const float*;
+		auto GetY() -> float*;
+		auto GetY() const -> const float*;
+		auto GetZ() -> float*;
+		auto GetZ() const -> const float*;
+		auto Item(int index) -> Reference;
+		auto Item(int index) const -> Vector3;
+
+		void SetCount(int count);
+		void Add(Vector3 vector);
+		void CopyFrom(const Vector3* vectors, int count);
+		void CopyTo(Vector3* vectors) const;
+
+	private:
+		FloatStream _x;
+		FloatStream _y;
+		FloatStream _z;
+	};
+
+	class Point3Stream
+	{
+	public:
+		class Reference
+		{
+		public:
+			float& X;
+			float& Y;
+			float& Z;
+
+			operator Point3() const;
+			auto operator=(Point3 point) -> Reference&;
+			auto operator=(const Reference& reference) -> Reference&;
+		};
+
+		Point3Stream() = default;
+		explicit Point3Stream(int count);
+		Point3Stream(const Point3* points, int count);
+
+		auto Count() const -> int;
+		auto PaddedCount() const -> int;
+		auto GetX() -> float*;
+		auto GetX() const -> const float*;
+		auto GetY() -> float*;
+		auto GetY() const -> const float*;
+		auto GetZ() -> float*;
+		auto GetZ() const -> const float*;
+		auto Item(int index) -> Reference;
+		auto Item(int index) const -> Point3;
+
+		void SetCount(int count);
+		void Add(Point3 point);
+		void CopyFrom(const Point3* points, int count);
+		void CopyTo(Point3* points) const;
+
+	private:
+		FloatStream _x;
+		FloatStream _y;
+		FloatStream _z;
+	};
+
+	class QuaternionStream
+	{
+	public:
+		class Reference
+		{
+		public:
+			float& X;
+			float& Y;
+			float& Z;
+			float& W;
+
+			operator Quaternion() const;
+			auto operator=(Quaternion quaternion) -> Reference&;
+			auto operator=(const Reference& reference) -> Reference&;
+		};
+
+		QuaternionStream() = default;
+		explicit QuaternionStream(int count);
+		QuaternionStream(const Quaternion* quaternions, int count);
+
+		auto Count() const -> int;
+		auto PaddedCount() const -> int;
+		auto GetX() -> float*;
+		auto GetX() const -> const float*;
+		auto GetY() -> float*;
+		auto GetY() const -> const float*;
+		auto GetZ() -> float*;
+		auto GetZ() const -> const float*;
+		auto GetW() -> float*;
+		auto GetW() const -> const float*;
+		auto Item(int index) -> Reference;
+		auto Item(int index) const -> Quaternion;
+
+		void SetCount(int count);
+		void Add(Quaternion quaternion);
+		void CopyFrom(const Quaternion* quaternions, int count);
+		void CopyTo(Quaternion* quaternions) const;
+
+	private:
+		FloatStream _x;
+		FloatStream _y;
+		FloatStream _z;
+		FloatStream _w;
+	};
+}
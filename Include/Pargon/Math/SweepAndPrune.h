@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Pargon/Math/Bounds.h"
+
+#include <memory>
+
+namespace Pargon
+{
+	// Keeps the set of overlapping pairs of a group of bodies from frame to frame. The minimum and maximum of every body
+	// are kept sorted along each axis, and Update insertion sorts them from their order on the previous frame, so when
+	// bodies move a little each frame the work is close to linear in the number of bodies. Two bodies can only start
+	// overlapping when the minimum of one passes the maximum of the other along some axis, so only those pairs and the
+	// pairs that were already overlapping are tested again. Bodies inserted since the last Update are merged in and
+	// found with a single sweep along the first axis.
+	//
+	// Insert, Move and Remove only record the change, and Update applies them and fills the lists of pairs that started
+	// and stopped overlapping. A removed body reports its pairs as removed and its index is not reused until after the
+	// Update that removes it. Bounds that touch count as overlapping.
+	class SweepAndPrune
+	{
+	public:
+		struct Pair
+		{
+			int First;
+			int Second;
+		};
+
+		SweepAndPrune();
+		SweepAndPrune(const SweepAndPrune& copy);
+		SweepAndPrune(SweepAndPrune&& move) noexcept;
+		~SweepAndPrune();
+
+		auto operator=(const SweepAndPrune& copy) -> SweepAndPrune&;
+		auto operator=(SweepAndPrune&& move) noexcept -> SweepAndPrune&;
+
+		auto Insert(const Aabb3& bounds) -> int;
+		void Move(int body, const Aabb3& bounds);
+		void Remove(int body);
+		void Update();
+
+		auto Count() const -> int;
+		auto GetBounds(int body) const -> const Aabb3&;
+
+		// Pairs are reported once with First less than Second, and the added and removed lists hold the changes made by
+		// the last Update. GetPairs writes GetPairCount pairs.
+		auto GetPairCount() const -> int;
+		auto HasPair(int first, int second) const -> bool;
+		void GetPairs(Pair* pairs) const;
+		auto GetAddedPairCount() const -> int;
+		auto GetAddedPairs() const -> const Pair*;
+		auto GetRemovedPairCount() const -> int;
+		auto GetRemovedPairs() const -> const Pair*;
+
+	private:
+		struct Data;
+		std::unique_ptr<Data> _data;
+		int _count = 0;
+	};
+}
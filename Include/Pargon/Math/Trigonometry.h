@@ -9,11 +9,37 @@ namespace Pargon
 	constexpr Angle Pi = 3.1415927_radians;
 	constexpr Angle PiOver2 = 1.5707963_radians;
 
-	auto Sine(Rotation rotation) -> float;
-	auto Cosine(Rotation rotation) -> float;
-	auto Tangent(Rotation rotation) -> float;
+	// Fast evaluates a polynomial approximation that is within 2 ULP of the correctly rounded Sine and Cosine and
+	// 4 ULP of Tangent for rotations up to 8192 radians, and within 3 ULP for the inverse functions. Larger rotations
+	// are reduced by the standard library. Inputs to ArcSine and ArcCosine are clamped to [-1, 1] in both modes.
+	// Precise forwards to the standard library.
+	enum class TrigonometryPrecision
+	{
+		Precise,
+		Fast
+	};
 
-	auto ArcSine(float value) -> Rotation;
-	auto ArcCosine(float value) -> Rotation;
-	auto ArcTangent(float x, float y) -> Rotation;
+	struct SineAndCosine
+	{
+		float Sine;
+		float Cosine;
+	};
+
+	auto Sine(Rotation rotation, TrigonometryPrecision precision = TrigonometryPrecision::Precise) -> float;
+	auto Cosine(Rotation rotation, TrigonometryPrecision precision = TrigonometryPrecision::Precise) -> float;
+	auto Tangent(Rotation rotation, TrigonometryPrecision precision = TrigonometryPrecision::Precise) -> float;
+	auto SineCosine(Rotation rotation, TrigonometryPrecision precision = TrigonometryPrecision::Precise) -> SineAndCosine;
+
+	void Sine(const Rotation* rotations, int count, float* results, TrigonometryPrecision precision = TrigonometryPrecision::Precise);
+	void Cosine(const Rotation* rotations, int count, float* results, TrigonometryPrecision precision = TrigonometryPrecision::Precise);
+	void Tangent(const Rotation* rotations, int count, float* results, TrigonometryPrecision precision = TrigonometryPrecision::Precise);
+	void SineCosine(const Rotation* rotations, int count, float* sines, float* cosines, TrigonometryPrecision precision = TrigonometryPrecision::Precise);
+
+	auto ArcSine(float value, TrigonometryPrecision precision = TrigonometryPrecision::Precise) -> Rotation;
+	auto ArcCosine(float value, TrigonometryPrecision precision = TrigonometryPrecision::Precise) -> Rotation;
+	auto ArcTangent(float x, float y, TrigonometryPrecision precision = TrigonometryPrecision::Precise) -> Rotation;
+
+	void ArcSine(const float* values, int count, Rotation* results, TrigonometryPrecision precision = TrigonometryPrecision::Precise);
+	void ArcCosine(const float* values, int count, Rotation* results, TrigonometryPrecision precision = TrigonometryPrecision::Precise);
+	void ArcTangent(const float* x, const float* y, int count, Rotation* results, TrigonometryPrecision precision = TrigonometryPrecision::Precise);
 }
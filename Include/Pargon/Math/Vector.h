@@ -5,12 +5,15 @@ namespace Pargon
 	class Angle;
 	class BufferReader;
 	class BufferWriter;
+	class FloatStream;
 	class Matrix3x3;
 	class Matrix4x4;
 	class Quaternion;
 	class StringReader;
 	class StringView;
 	class StringWriter;
+	class Vector2Stream;
+	class Vector3Stream;
 
 	class Vector2
 	{
@@ -102,6 +105,29 @@ namespace Pargon
 		void ToString(StringWriter& writer, StringView format) const;
 		void FromString(StringReader& reader, StringView format);
 	};
+
+	// Fast uses the hardware reciprocal square root refined with one Newton step and lands within 5e-7 of the
+	// exact result. Vectors whose squared length is below the smallest normal float are replaced by the fallback.
+	enum class NormalizeAccuracy
+	{
+		Precise,
+		Fast
+	};
+
+	void TransformVectors(const Vector2* vectors, int count, const Matrix3x3& transform, Vector2* results);
+	void TransformVectors(const Vector3* vectors, int count, const Matrix4x4& transform, Vector3* results);
+	void Normalize(Vector2* vectors, int count, NormalizeAccuracy accuracy = NormalizeAccuracy::Precise, Vector2 fallback = { 0.0f, 0.0f });
+	void Normalize(Vector3* vectors, int count, NormalizeAccuracy accuracy = NormalizeAccuracy::Precise, Vector3 fallback = { 0.0f, 0.0f, 0.0f });
+
+	void GetLengths(const Vector2Stream& vectors, FloatStream& results);
+	void GetLengths(const Vector3Stream& vectors, FloatStream& results);
+	void GetDotProducts(const Vector2Stream& left, const Vector2Stream& right, FloatStream& results);
+	void GetDotProducts(const Vector3Stream& left, const Vector3Stream& right, FloatStream& results);
+	void GetCrossProducts(const Vector3Stream& left, const Vector3Stream& right, Vector3Stream& results);
+	void Normalize(Vector2Stream& vectors, NormalizeAccuracy accuracy = NormalizeAccuracy::Precise, Vector2 fallback = { 0.0f, 0.0f });
+	void Normalize(Vector3Stream& vectors, NormalizeAccuracy accuracy = NormalizeAccuracy::Precise, Vector3 fallback = { 0.0f, 0.0f, 0.0f });
+	void TransformVectors(const Vector2Stream& vectors, const Matrix3x3& transform, Vector2Stream& results);
+	void TransformVectors(const Vector3Stream& vectors, const Matrix4x4& transform, Vector3Stream& results);
 }
 
 constexpr
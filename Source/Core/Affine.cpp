@@ -0,0 +1,481 @@
+#include "Pargon/Math/Affine.h"
+#include "Pargon/Math/Matrix.h"
+#include "Pargon/Math/Trigonometry.h"
+#include "Pargon/Serialization/BufferReader.h"
+#include "Pargon/Serialization/BufferWriter.h"
+#include "Pargon/Serialization/StringReader.h"
+#include "Pargon/Serialization/StringWriter.h"
+#include "Core/Simd.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace Pargon;
+
+namespace
+{
+	void Multiply3x4(const float* left, const float* right, float* result)
+	{
+#if PARGON_MATH_SSE
+		auto left0 = _mm_load_ps(left + 0);
+		auto left1 = _mm_load_ps(left + 4);
+		auto left2 = _mm_load_ps(left + 8);
+		auto right0 = _mm_load_ps(right + 0);
+		auto right1 = _mm_load_ps(right + 4);
+		auto right2 = _mm_load_ps(right + 8);
+		auto translation = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1));
+
+		auto result0 = Simd::MultiplyAdd(Simd::Splat<2>(right0), left2, Simd::MultiplyAdd(Simd::Splat<1>(right0), left1, _mm_mul_ps(Simd::Splat<0>(right0), left0)));
+		auto result1 = Simd::MultiplyAdd(Simd::Splat<2>(right1), left2, Simd::MultiplyAdd(Simd::Splat<1>(right1), left1, _mm_mul_ps(Simd::Splat<0>(right1), left0)));
+		auto result2 = Simd::MultiplyAdd(Simd::Splat<2>(right2), left2, Simd::MultiplyAdd(Simd::Splat<1>(right2), left1, _mm_mul_ps(Simd::Splat<0>(right2), left0)));
+
+		_mm_store_ps(result + 0, _mm_add_ps(result0, _mm_and_ps(right0, translation)));
+		_mm_store_ps(result + 4, _mm_add_ps(result1, _mm_and_ps(right1, translation)));
+		_mm_store_ps(result + 8, _mm_add_ps(result2, _mm_and_ps(right2, translation)));
+#else
+		float product[12];
+
+		for (auto row = 0; row < 3; row++)
+		{
+			for (auto column = 0; column < 4; column++)
+				product[row * 4 + column] = right[row * 4 + 0] * left[column] + right[row * 4 + 1] * left[4 + column] + right[row * 4 + 2] * left[8 + column];
+
+			product[row * 4 + 3] += right[row * 4 + 3];
+		}
+
+		std::copy(product, product + 12, result);
+#endif
+	}
+
+	void Invert3x4(float* affine)
+	{
+#if PARGON_MATH_SSE
+		auto row0 = _mm_load_ps(affine + 0);
+		auto row1 = _mm_load_ps(affine + 4);
+		auto row2 = _mm_load_ps(affine + 8);
+
+		auto column0 = Simd::Cross(row1, row2);
+		auto column1 = Simd::Cross(row2, row0);
+		auto column2 = Simd::Cross(row0, row1);
+		auto determinant = _mm_div_ps(_mm_set1_ps(1.0f), Simd::Dot3(row0, column0));
+
+		column0 = _mm_mul_ps(column0, determinant);
+		column1 = _mm_mul_ps(column1, determinant);
+		column2 = _mm_mul_ps(column2, determinant);
+
+		auto offset = _mm_mul_ps(Simd::Splat<3>(row0), column0);
+		offset = Simd::MultiplyAdd(Simd::Splat<3>(row1), column1, offset);
+		offset = Simd::MultiplyAdd(Simd::Splat<3>(row2), column2, offset);
+		offset = _mm_sub_ps(_mm_setzero_ps(), offset);
+
+		_MM_TRANSPOSE4_PS(column0, column1, column2, offset);
+
+		_mm_store_ps(affine + 0, column0);
+		_mm_store_ps(affine + 4, column1);
+		_mm_store_ps(affine + 8, column2);
+#else
+		float inverse[12] =
+		{
+			affine[5] * affine[10] - affine[6] * affine[9], affine[9] * affine[2] - affine[10] * affine[1], affine[1] * affine[6] - affine[2] * affine[5], 0.0f,
+			affine[6] * affine[8] - affine[4] * affine[10], affine[10] * affine[0] - affine[8] * affine[2], affine[2] * affine[4] - affine[0] * affine[6], 0.0f,
+			affine[4] * affine[9] - affine[5] * affine[8], affine[8] * affine[1] - affine[9] * affine[0], affine[0] * affine[5] - affine[1] * affine[4], 0.0f
+		};
+
+		auto determinant = 1.0f / (affine[0] * inverse[0] + affine[1] * inverse[4] + affine[2] * inverse[8]);
+
+		for (auto row = 0; row < 3; row++)
+		{
+			for (auto column = 0; column < 3; column++)
+			{
+				inverse[row * 4 + column] *= determinant;
+				inverse[row * 4 + 3] -= inverse[row * 4 + column] * affine[column * 4 + 3];
+			}
+		}
+
+		std::copy(inverse, inverse + 12, affine);
+#endif
+	}
+}
+
+auto Affine2x3::CreateRotation(Rotation angle) -> Affine2x3
+{
+	auto rotation = SineCosine(angle);
+
+	return
+	{
+		rotation.Cosine, rotation.Sine, 0.0f,
+		-rotation.Sine, rotation.Cosine, 0.0f
+	};
+}
+
+auto Affine2x3::CreateTransform(Vector2 position, Vector2 scale, Rotation angle, Vector2 offset) -> Affine2x3
+{
+	auto rotation = SineCosine(angle);
+
+	auto row1column1 = rotation.Cosine * scale.X;
+	auto row1column2 = -rotation.Sine * scale.Y;
+	auto row2column1 = rotation.Sine * scale.X;
+	auto row2column2 = rotation.Cosine * scale.Y;
+
+	return
+	{
+		row1column1, row1column2, position.X - row1column1 * offset.X - row1column2 * offset.Y,
+		row2column1, row2column2, position.Y - row2column1 * offset.X - row2column2 * offset.Y
+	};
+}
+
+auto Affine2x3::CreateFromMatrix(const Matrix3x3& matrix) -> Affine2x3
+{
+	auto& m = matrix.Elements;
+
+	return
+	{
+		m.Item(0), m.Item(3), m.Item(6),
+		m.Item(1), m.Item(4), m.Item(7)
+	};
+}
+
+auto Affine2x3::operator==(const Affine2x3& right) const -> bool
+{
+	return std::equal(Elements.begin(), Elements.end(), right.Elements.begin());
+}
+
+auto Affine2x3::operator!=(const Affine2x3& right) const -> bool
+{
+	return !operator==(right);
+}
+
+auto Affine2x3::operator*=(const Affine2x3& right) -> Affine2x3&
+{
+	*this = *this * right;
+	return *this;
+}
+
+auto Affine2x3::operator*(const Affine2x3& right) const -> Affine2x3
+{
+	auto& l = Elements;
+	auto& r = right.Elements;
+
+	return
+	{
+		r.Item(0) * l.Item(0) + r.Item(1) * l.Item(3), r.Item(0) * l.Item(1) + r.Item(1) * l.Item(4), r.Item(0) * l.Item(2) + r.Item(1) * l.Item(5) + r.Item(2),
+		r.Item(3) * l.Item(0) + r.Item(4) * l.Item(3), r.Item(3) * l.Item(1) + r.Item(4) * l.Item(4), r.Item(3) * l.Item(2) + r.Item(4) * l.Item(5) + r.Item(5)
+	};
+}
+
+auto Affine2x3::Get(int row, int column) const -> float
+{
+	assert(row >= 0 && row < 2 && column >= 0 && column < 3);
+	return Elements.Item(row * 3 + column);
+}
+
+void Affine2x3::Set(int row, int column, float value)
+{
+	assert(row >= 0 && row < 2 && column >= 0 && column < 3);
+	Elements.Item(row * 3 + column) = value;
+}
+
+auto Affine2x3::GetDeterminant() const -> float
+{
+	return Elements.Item(0) * Elements.Item(4) - Elements.Item(1) * Elements.Item(3);
+}
+
+auto Affine2x3::GetTranslation() const -> Vector2
+{
+	return { Elements.Item(2), Elements.Item(5) };
+}
+
+auto Affine2x3::Get3x3() const -> Matrix3x3
+{
+	auto& e = Elements;
+
+	return
+	{
+		e.Item(0), e.Item(3), 0.0f,
+		e.Item(1), e.Item(4), 0.0f,
+		e.Item(2), e.Item(5), 1.0f
+	};
+}
+
+auto Affine2x3::TransformPoint(Point2 point) const -> Point2
+{
+	auto& e = Elements;
+
+	return
+	{
+		e.Item(0) * point.X + e.Item(1) * point.Y + e.Item(2),
+		e.Item(3) * point.X + e.Item(4) * point.Y + e.Item(5)
+	};
+}
+
+auto Affine2x3::TransformVector(Vector2 vector) const -> Vector2
+{
+	auto& e = Elements;
+
+	return
+	{
+		e.Item(0) * vector.X + e.Item(1) * vector.Y,
+		e.Item(3) * vector.X + e.Item(4) * vector.Y
+	};
+}
+
+void Affine2x3::Invert()
+{
+	auto& e = Elements;
+	auto determinant = 1.0f / GetDeterminant();
+
+	auto row1column1 = e.Item(4) * determinant;
+	auto row1column2 = -e.Item(1) * determinant;
+	auto row2column1 = -e.Item(3) * determinant;
+	auto row2column2 = e.Item(0) * determinant;
+
+	*this =
+	{
+		row1column1, row1column2, -(row1column1 * e.Item(2) + row1column2 * e.Item(5)),
+		row2column1, row2column2, -(row2column1 * e.Item(2) + row2column2 * e.Item(5))
+	};
+}
+
+void Affine2x3::Translate(Vector2 translation)
+{
+	Elements.Item(2) += translation.X;
+	Elements.Item(5) += translation.Y;
+}
+
+void Affine2x3::Scale(Vector2 scale)
+{
+	Elements.Item(0) *= scale.X;
+	Elements.Item(1) *= scale.X;
+	Elements.Item(2) *= scale.X;
+	Elements.Item(3) *= scale.Y;
+	Elements.Item(4) *= scale.Y;
+	Elements.Item(5) *= scale.Y;
+}
+
+void Affine2x3::Rotate(Rotation angle)
+{
+	auto& e = Elements;
+	auto rotation = SineCosine(angle);
+
+	*this =
+	{
+		rotation.Cosine * e.Item(0) - rotation.Sine * e.Item(3), rotation.Cosine * e.Item(1) - rotation.Sine * e.Item(4), rotation.Cosine * e.Item(2) - rotation.Sine * e.Item(5),
+		rotation.Cosine * e.Item(3) + rotation.Sine * e.Item(0), rotation.Cosine * e.Item(4) + rotation.Sine * e.Item(1), rotation.Cosine * e.Item(5) + rotation.Sine * e.Item(2)
+	};
+}
+
+auto Affine2x3::Inverted() const -> Affine2x3
+{
+	auto copy = *this;
+	copy.Invert();
+	return copy;
+}
+
+auto Affine2x3::Translated(Vector2 translation) const -> Affine2x3
+{
+	auto copy = *this;
+	copy.Translate(translation);
+	return copy;
+}
+
+auto Affine2x3::Scaled(Vector2 scale) const -> Affine2x3
+{
+	auto copy = *this;
+	copy.Scale(scale);
+	return copy;
+}
+
+auto Affine2x3::Rotated(Rotation angle) const -> Affine2x3
+{
+	auto copy = *this;
+	copy.Rotate(angle);
+	return copy;
+}
+
+void Affine2x3::ToBuffer(BufferWriter& writer) const
+{
+	writer.Write(Elements);
+}
+
+void Affine2x3::FromBuffer(BufferReader& reader)
+{
+	reader.Read(Elements);
+}
+
+void Affine2x3::ToString(StringWriter& writer, StringView format) const
+{
+	writer.Write(Elements, format);
+}
+
+void Affine2x3::FromString(StringReader& reader, StringView format)
+{
+	reader.Read(Elements, format);
+}
+
+auto Affine3x4::CreateFromMatrix(const Matrix4x4& matrix) -> Affine3x4
+{
+	auto& m = matrix.Elements;
+
+	return
+	{
+		m.Item(0), m.Item(4), m.Item(8), m.Item(12),
+		m.Item(1), m.Item(5), m.Item(9), m.Item(13),
+		m.Item(2), m.Item(6), m.Item(10), m.Item(14)
+	};
+}
+
+auto Affine3x4::operator==(const Affine3x4& right) const -> bool
+{
+	return std::equal(Elements.begin(), Elements.end(), right.Elements.begin());
+}
+
+auto Affine3x4::operator!=(const Affine3x4& right) const -> bool
+{
+	return !operator==(right);
+}
+
+auto Affine3x4::operator*=(const Affine3x4& right) -> Affine3x4&
+{
+	Multiply3x4(Elements.begin(), right.Elements.begin(), Elements.begin());
+	return *this;
+}
+
+auto Affine3x4::operator*(const Affine3x4& right) const -> Affine3x4
+{
+	Affine3x4 affine;
+	Multiply3x4(Elements.begin(), right.Elements.begin(), affine.Elements.begin());
+	return affine;
+}
+
+auto Affine3x4::Get(int row, int column) const -> float
+{
+	assert(row >= 0 && row < 3 && column >= 0 && column < 4);
+	return Elements.Item(row * 4 + column);
+}
+
+void Affine3x4::Set(int row, int column, float value)
+{
+	assert(row >= 0 && row < 3 && column >= 0 && column < 4);
+	Elements.Item(row * 4 + column) = value;
+}
+
+auto Affine3x4::GetDeterminant() const -> float
+{
+	auto& e = Elements;
+
+	return e.Item(0) * (e.Item(5) * e.Item(10) - e.Item(6) * e.Item(9))
+		- e.Item(1) * (e.Item(4) * e.Item(10) - e.Item(6) * e.Item(8))
+		+ e.Item(2) * (e.Item(4) * e.Item(9) - e.Item(5) * e.Item(8));
+}
+
+auto Affine3x4::GetTranslation() const -> Vector3
+{
+	return { Elements.Item(3), Elements.Item(7), Elements.Item(11) };
+}
+
+auto Affine3x4::Get4x4() const -> Matrix4x4
+{
+	auto& e = Elements;
+
+	return
+	{
+		e.Item(0), e.Item(4), e.Item(8), 0.0f,
+		e.Item(1), e.Item(5), e.Item(9), 0.0f,
+		e.Item(2), e.Item(6), e.Item(10), 0.0f,
+		e.Item(3), e.Item(7), e.Item(11), 1.0f
+	};
+}
+
+auto Affine3x4::TransformPoint(Point3 point) const -> Point3
+{
+	auto& e = Elements;
+
+	return
+	{
+		e.Item(0) * point.X + e.Item(1) * point.Y + e.Item(2) * point.Z + e.Item(3),
+		e.Item(4) * point.X + e.Item(5) * point.Y + e.Item(6) * point.Z + e.Item(7),
+		e.Item(8) * point.X + e.Item(9) * point.Y + e.Item(10) * point.Z + e.Item(11)
+	};
+}
+
+auto Affine3x4::TransformVector(Vector3 vector) const -> Vector3
+{
+	auto& e = Elements;
+
+	return
+	{
+		e.Item(0) * vector.X + e.Item(1) * vector.Y + e.Item(2) * vector.Z,
+		e.Item(4) * vector.X + e.Item(5) * vector.Y + e.Item(6) * vector.Z,
+		e.Item(8) * vector.X + e.Item(9) * vector.Y + e.Item(10) * vector.Z
+	};
+}
+
+void Affine3x4::Invert()
+{
+	Invert3x4(Elements.begin());
+}
+
+auto Affine3x4::Inverted() const -> Affine3x4
+{
+	auto copy = *this;
+	copy.Invert();
+	return copy;
+}
+
+void Affine3x4::ToBuffer(BufferWriter& writer) const
+{
+	writer.Write(Elements);
+}
+
+void Affine3x4::FromBuffer(BufferReader& reader)
+{
+	reader.Read(Elements);
+}
+
+void Affine3x4::ToString(StringWriter& writer, StringView format) const
+{
+	writer.Write(Elements, format);
+}
+
+void Affine3x4::FromString(StringReader& reader, StringView format)
+{
+	reader.Read(Elements, format);
+}
+
+void Pargon::TransformPoints(const Point2* points, int count, const Affine2x3& transform, Point2* results)
+{
+	auto index = 0;
+	auto& e = transform.Elements;
+
+	auto e0 = Simd::Wide::Broadcast(e.Item(0)), e1 = Simd::Wide::Broadcast(e.Item(1)), e2 = Simd::Wide::Broadcast(e.Item(2));
+	auto e3 = Simd::Wide::Broadcast(e.Item(3)), e4 = Simd::Wide::Broadcast(e.Item(4)), e5 = Simd::Wide::Broadcast(e.Item(5));
+
+	for (; index + Simd::Wide::Width <= count; index += Simd::Wide::Width)
+	{
+		Simd::Wide x, y;
+		Simd::LoadInterleaved2(&points[index].X, x, y);
+		Simd::StoreInterleaved2(&results[index].X, Simd::MultiplyAdd(y, e1, Simd::MultiplyAdd(x, e0, e2)), Simd::MultiplyAdd(y, e4, Simd::MultiplyAdd(x, e3, e5)));
+	}
+
+	for (; index < count; index++)
+		results[index] = transform.TransformPoint(points[index]);
+}
+
+void Pargon::TransformVectors(const Vector2* vectors, int count, const Affine2x3& transform, Vector2* results)
+{
+	auto index = 0;
+	auto& e = transform.Elements;
+
+	auto e0 = Simd::Wide::Broadcast(e.Item(0)), e1 = Simd::Wide::Broadcast(e.Item(1));
+	auto e3 = Simd::Wide::Broadcast(e.Item(3)), e4 = Simd::Wide::Broadcast(e.Item(4));
+
+	for (; index + Simd::Wide::Width <= count; index += Simd::Wide::Width)
+	{
+		Simd::Wide x, y;
+		Simd::LoadInterleaved2(&vectors[index].X, x, y);
+		Simd::StoreInterleaved2(&results[index].X, Simd::MultiplyAdd(y, e1, x * e0), Simd::MultiplyAdd(y, e4, x * e3));
+	}
+
+	for (; index < count; index++)
+		results[index] = transform.TransformVector(vectors[index]);
+}
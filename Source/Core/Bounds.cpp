@@ -0,0 +1,1307 @@
+#include "Pargon/Math/Bounds.h"
+#include "Pargon/Math/Matrix.h"
+#include "Pargon/Math/Stream.h"
+#include "Pargon/Serialization/BufferReader.h"
+#include "Pargon/Serialization/BufferWriter.h"
+#include "Pargon/Serialization/StringReader.h"
+#include "Pargon/Serialization/StringWriter.h"
+#include "Core/Simd.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+using namespace Pargon;
+
+namespace
+{
+	constexpr int _jacobiSweeps = 16;
+	constexpr float _parallelEpsilon = 1e-6f;
+	constexpr float _degenerateLength = 1e-12f;
+
+	auto ReduceMinimum(Simd::Wide value) -> float
+	{
+		alignas(32) float values[Simd::Wide::Width];
+		value.Store(values);
+		return *std::min_element(values, values + Simd::Wide::Width);
+	}
+
+	auto ReduceMaximum(Simd::Wide value) -> float
+	{
+		alignas(32) float values[Simd::Wide::Width];
+		value.Store(values);
+		return *std::max_element(values, values + Simd::Wide::Width);
+	}
+
+	// The trailing points that do not fill a block are passed broadcast to every lane, which only suits operations
+	// like minimum and maximum where repeating a point does not change the result.
+
+	template<typename Block>
+	void ForEachPointBlock(const Point2* points, int count, Block block)
+	{
+		auto index = 0;
+
+		for (; index + Simd::Wide::Width <= count; index += Simd::Wide::Width)
+		{
+			Simd::Wide x, y;
+			Simd::LoadInterleaved2(&points[index].X, x, y);
+			block(x, y);
+		}
+
+		for (; index < count; index++)
+			block(Simd::Wide::Broadcast(points[index].X), Simd::Wide::Broadcast(points[index].Y));
+	}
+
+	template<typename Block>
+	void ForEachPointBlock(const Point3* points, int count, Block block)
+	{
+		auto index = 0;
+
+		for (; index + Simd::Wide::Width <= count; index += Simd::Wide::Width)
+		{
+			Simd::Wide x, y, z;
+			Simd::LoadInterleaved3(&points[index].X, x, y, z);
+			block(x, y, z);
+		}
+
+		for (; index < count; index++)
+			block(Simd::Wide::Broadcast(points[index].X), Simd::Wide::Broadcast(points[index].Y), Simd::Wide::Broadcast(points[index].Z));
+	}
+
+	template<typename Block>
+	void ForEachPointBlock(const Point3Stream& points, Block block)
+	{
+		auto index = 0;
+		auto count = points.Count();
+
+		for (; index + Simd::Wide::Width <= count; index += Simd::Wide::Width)
+			block(Simd::Wide::Load(points.GetX() + index), Simd::Wide::Load(points.GetY() + index), Simd::Wide::Load(points.GetZ() + index));
+
+		for (; index < count; index++)
+			block(Simd::Wide::Broadcast(points.GetX()[index]), Simd::Wide::Broadcast(points.GetY()[index]), Simd::Wide::Broadcast(points.GetZ()[index]));
+	}
+
+	template<typename Points>
+	auto GetBounds(const Points& forEach) -> Aabb3
+	{
+		auto infinity = std::numeric_limits<float>::infinity();
+		auto minimumX = Simd::Wide::Broadcast(infinity), minimumY = minimumX, minimumZ = minimumX;
+		auto maximumX = Simd::Wide::Broadcast(-infinity), maximumY = maximumX, maximumZ = maximumX;
+
+		forEach([&](Simd::Wide x, Simd::Wide y, Simd::Wide z)
+		{
+			minimumX = Simd::Minimum(minimumX, x);
+			minimumY = Simd::Minimum(minimumY, y);
+			minimumZ = Simd::Minimum(minimumZ, z);
+			maximumX = Simd::Maximum(maximumX, x);
+			maximumY = Simd::Maximum(maximumY, y);
+			maximumZ = Simd::Maximum(maximumZ, z);
+		});
+
+		return { { ReduceMinimum(minimumX), ReduceMinimum(minimumY), ReduceMinimum(minimumZ) }, { ReduceMaximum(maximumX), ReduceMaximum(maximumY), ReduceMaximum(maximumZ) } };
+	}
+
+	template<typename Points>
+	auto GetSphere(const Points& forEach) -> BoundingSphere
+	{
+		auto center = GetBounds(forEach).GetCenter();
+		auto centerX = Simd::Wide::Broadcast(center.X), centerY = Simd::Wide::Broadcast(center.Y), centerZ = Simd::Wide::Broadcast(center.Z);
+		auto farthest = Simd::Wide::Broadcast(0.0f);
+
+		forEach([&](Simd::Wide x, Simd::Wide y, Simd::Wide z)
+		{
+			auto offsetX = x - centerX, offsetY = y - centerY, offsetZ = z - centerZ;
+			farthest = Simd::Maximum(farthest, Simd::MultiplyAdd(offsetZ, offsetZ, Simd::MultiplyAdd(offsetY, offsetY, offsetX * offsetX)));
+		});
+
+		return { center, std::sqrt(ReduceMaximum(farthest)) };
+	}
+
+	auto Dot(Vector3 left, Vector3 right) -> float
+	{
+		return left.X * right.X + left.Y * right.Y + left.Z * right.Z;
+	}
+
+	auto Component(Vector3 vector, int index) -> float
+	{
+		return index == 0 ? vector.X : (index == 1 ? vector.Y : vector.Z);
+	}
+
+	void SetComponent(Vector3& vector, int index, float value)
+	{
+		(index == 0 ? vector.X : (index == 1 ? vector.Y : vector.Z)) = value;
+	}
+
+	// Cyclic Jacobi rotations on the covariance matrix. The columns of vectors end up as its eigenvectors.
+	void GetPrincipalAxes(double (&covariance)[3][3], Array<Vector3, 3>& axes)
+	{
+		double vectors[3][3] = { { 1.0, 0.0, 0.0 }, { 0.0, 1.0, 0.0 }, { 0.0, 0.0, 1.0 } };
+
+		for (auto sweep = 0; sweep < _jacobiSweeps; sweep++)
+		{
+			auto offDiagonal = std::abs(covariance[0][1]) + std::abs(covariance[0][2]) + std::abs(covariance[1][2]);
+			auto diagonal = std::abs(covariance[0][0]) + std::abs(covariance[1][1]) + std::abs(covariance[2][2]);
+
+			if (offDiagonal <= diagonal * 1e-12)
+				break;
+
+			for (auto p = 0; p < 2; p++)
+			{
+				for (auto q = p + 1; q < 3; q++)
+				{
+					if (covariance[p][q] == 0.0)
+						continue;
+
+					auto theta = (covariance[q][q] - covariance[p][p]) / (2.0 * covariance[p][q]);
+					auto t = (theta < 0.0 ? -1.0 : 1.0) / (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+					auto c = 1.0 / std::sqrt(t * t + 1.0);
+					auto s = t * c;
+
+					for (auto k = 0; k < 3; k++)
+					{
+						auto kp = covariance[k][p], kq = covariance[k][q];
+						covariance[k][p] = c * kp - s * kq;
+						covariance[k][q] = s * kp + c * kq;
+					}
+
+					for (auto k = 0; k < 3; k++)
+					{
+						auto pk = covariance[p][k], qk = covariance[q][k];
+						covariance[p][k] = c * pk - s * qk;
+						covariance[q][k] = s * pk + c * qk;
+					}
+
+					for (auto k = 0; k < 3; k++)
+					{
+						auto kp = vectors[k][p], kq = vectors[k][q];
+						vectors[k][p] = c * kp - s * kq;
+						vectors[k][q] = s * kp + c * kq;
+					}
+				}
+			}
+		}
+
+		for (auto axis = 0; axis < 2; axis++)
+			axes.Item(axis) = Vector3{ static_cast<float>(vectors[0][axis]), static_cast<float>(vectors[1][axis]), static_cast<float>(vectors[2][axis]) }.Normalized();
+
+		axes.Item(1) = (axes.Item(1) - axes.Item(0) * Dot(axes.Item(0), axes.Item(1))).Normalized();
+		axes.Item(2) = axes.Item(0).GetCrossProduct(axes.Item(1));
+	}
+
+	template<typename Points, typename GetPoint>
+	auto GetBox(const Points& forEach, int count, GetPoint getPoint) -> Obb
+	{
+		assert(count > 0);
+
+		double mean[3] = {};
+
+		for (auto index = 0; index < count; index++)
+		{
+			auto point = getPoint(index);
+			mean[0] += point.X;
+			mean[1] += point.Y;
+			mean[2] += point.Z;
+		}
+
+		for (auto& value : mean)
+			value /= count;
+
+		double covariance[3][3] = {};
+
+		for (auto index = 0; index < count; index++)
+		{
+			auto point = getPoint(index);
+			double offset[3] = { point.X - mean[0], point.Y - mean[1], point.Z - mean[2] };
+
+			for (auto row = 0; row < 3; row++)
+			{
+				for (auto column = row; column < 3; column++)
+					covariance[row][column] += offset[row] * offset[column];
+			}
+		}
+
+		for (auto row = 1; row < 3; row++)
+		{
+			for (auto column = 0; column < row; column++)
+				covariance[row][column] = covariance[column][row];
+		}
+
+		Obb box;
+		GetPrincipalAxes(covariance, box.Axes);
+
+		Simd::Wide axisX[3], axisY[3], axisZ[3], minimum[3], maximum[3];
+
+		for (auto axis = 0; axis < 3; axis++)
+		{
+			axisX[axis] = Simd::Wide::Broadcast(box.Axes.Item(axis).X);
+			axisY[axis] = Simd::Wide::Broadcast(box.Axes.Item(axis).Y);
+			axisZ[axis] = Simd::Wide::Broadcast(box.Axes.Item(axis).Z);
+			minimum[axis] = Simd::Wide::Broadcast(std::numeric_limits<float>::infinity());
+			maximum[axis] = Simd::Wide::Broadcast(-std::numeric_limits<float>::infinity());
+		}
+
+		forEach([&](Simd::Wide x, Simd::Wide y, Simd::Wide z)
+		{
+			for (auto axis = 0; axis < 3; axis++)
+			{
+				auto projection = Simd::MultiplyAdd(z, axisZ[axis], Simd::MultiplyAdd(y, axisY[axis], x * axisX[axis]));
+				minimum[axis] = Simd::Minimum(minimum[axis], projection);
+				maximum[axis] = Simd::Maximum(maximum[axis], projection);
+			}
+		});
+
+		auto center = Vector3{ 0.0f, 0.0f, 0.0f };
+
+		for (auto axis = 0; axis < 3; axis++)
+		{
+			auto low = ReduceMinimum(minimum[axis]);
+			auto high = ReduceMaximum(maximum[axis]);
+
+			SetComponent(box.Extents, axis, (high - low) * 0.5f);
+			center += box.Axes.Item(axis) * ((high + low) * 0.5f);
+		}
+
+		box.Center = { center.X, center.Y, center.Z };
+		return box;
+	}
+
+	auto GetPerpendicular(Vector3 vector) -> Vector3
+	{
+		auto other = std::abs(vector.X) < 0.9f ? Vector3{ 1.0f, 0.0f, 0.0f } : Vector3{ 0.0f, 1.0f, 0.0f };
+		return vector.GetCrossProduct(other).Normalized();
+	}
+
+	// Builds a right handed orthonormal basis from the transformed half axes, falling back to arbitrary directions
+	// when a transform collapses them, and sizes the extents to enclose all three.
+	void FitBasis(const Vector3 (&halfAxes)[3], Obb& box)
+	{
+		auto first = 0;
+
+		for (auto axis = 1; axis < 3; axis++)
+		{
+			if (halfAxes[axis].GetLengthSquared() > halfAxes[first].GetLengthSquared())
+				first = axis;
+		}
+
+		auto& axes = box.Axes;
+		auto length = halfAxes[first].GetLengthSquared();
+		axes.Item(0) = length > _degenerateLength ? halfAxes[first] * (1.0f / std::sqrt(length)) : Vector3{ 1.0f, 0.0f, 0.0f };
+
+		auto second = halfAxes[(first + 1) % 3] - axes.Item(0) * Dot(axes.Item(0), halfAxes[(first + 1) % 3]);
+
+		if (second.GetLengthSquared() <= _degenerateLength)
+			second = halfAxes[(first + 2) % 3] - axes.Item(0) * Dot(axes.Item(0), halfAxes[(first + 2) % 3]);
+
+		length = second.GetLengthSquared();
+		axes.Item(1) = length > _degenerateLength ? second * (1.0f / std::sqrt(length)) : GetPerpendicular(axes.Item(0));
+		axes.Item(2) = axes.Item(0).GetCrossProduct(axes.Item(1));
+
+		for (auto axis = 0; axis < 3; axis++)
+			SetComponent(box.Extents, axis, std::abs(Dot(halfAxes[0], axes.Item(axis))) + std::abs(Dot(halfAxes[1], axes.Item(axis))) + std::abs(Dot(halfAxes[2], axes.Item(axis))));
+	}
+
+#if PARGON_MATH_SSE
+	auto Load3(const float* data, float w) -> __m128
+	{
+		return _mm_setr_ps(data[0], data[1], data[2], w);
+	}
+
+	void Store3(float* data, __m128 value)
+	{
+		_mm_storel_pi(reinterpret_cast<__m64*>(data), value);
+		_mm_store_ss(data + 2, Simd::Splat<2>(value));
+	}
+
+	auto Absolute(__m128 value) -> __m128
+	{
+		return _mm_andnot_ps(_mm_set1_ps(-0.0f), value);
+	}
+
+	struct Rows
+	{
+		__m128 Row[4];
+		__m128 AbsoluteRow[3];
+
+		explicit Rows(const Matrix4x4& transform)
+		{
+			for (auto row = 0; row < 4; row++)
+				Row[row] = _mm_loadu_ps(transform.Elements.begin() + row * 4);
+
+			for (auto row = 0; row < 3; row++)
+				AbsoluteRow[row] = Absolute(Row[row]);
+		}
+	};
+
+	void TransformBox(const Aabb3& bounds, const Rows& rows, Aabb3& result)
+	{
+		auto minimum = Load3(&bounds.Minimum.X, 1.0f);
+		auto maximum = Load3(&bounds.Maximum.X, 1.0f);
+		auto half = _mm_set1_ps(0.5f);
+
+		auto center = Simd::MultiplyRow(_mm_mul_ps(_mm_add_ps(minimum, maximum), half), rows.Row[0], rows.Row[1], rows.Row[2], rows.Row[3]);
+		auto extents = _mm_mul_ps(_mm_sub_ps(maximum, minimum), half);
+		extents = Simd::MultiplyAdd(Simd::Splat<2>(extents), rows.AbsoluteRow[2], Simd::MultiplyAdd(Simd::Splat<1>(extents), rows.AbsoluteRow[1], _mm_mul_ps(Simd::Splat<0>(extents), rows.AbsoluteRow[0])));
+
+		Store3(&result.Minimum.X, _mm_sub_ps(center, extents));
+		Store3(&result.Maximum.X, _mm_add_ps(center, extents));
+	}
+
+	void TransformSphere(const BoundingSphere& sphere, const Rows& rows, BoundingSphere& result)
+	{
+		auto value = _mm_load_ps(&sphere.Center.X);
+		auto point = Simd::Shuffle<0, 1, 0, 2>(value, Simd::Shuffle<2, 2, 0, 0>(value, _mm_set1_ps(1.0f)));
+		auto center = Simd::MultiplyRow(point, rows.Row[0], rows.Row[1], rows.Row[2], rows.Row[3]);
+
+		auto row00 = Simd::Dot3(rows.Row[0], rows.Row[0]), row11 = Simd::Dot3(rows.Row[1], rows.Row[1]), row22 = Simd::Dot3(rows.Row[2], rows.Row[2]);
+		auto row01 = Absolute(Simd::Dot3(rows.Row[0], rows.Row[1])), row02 = Absolute(Simd::Dot3(rows.Row[0], rows.Row[2])), row12 = Absolute(Simd::Dot3(rows.Row[1], rows.Row[2]));
+
+		auto scale = _mm_add_ps(row00, _mm_add_ps(row01, row02));
+		scale = _mm_max_ps(scale, _mm_add_ps(row11, _mm_add_ps(row01, row12)));
+		scale = _mm_max_ps(scale, _mm_add_ps(row22, _mm_add_ps(row02, row12)));
+
+		auto radius = _mm_mul_ps(Simd::Splat<3>(value), _mm_sqrt_ps(scale));
+
+		_mm_store_ps(&result.Center.X, Simd::Shuffle<0, 1, 0, 2>(center, Simd::Shuffle<2, 2, 0, 0>(center, radius)));
+	}
+
+	void TransformBox(const Obb& box, const Rows& rows, Obb& result)
+	{
+		__m128 halfAxes[3];
+
+		for (auto axis = 0; axis < 3; axis++)
+			halfAxes[axis] = Simd::MultiplyRow(_mm_mul_ps(Load3(&box.Axes.Item(axis).X, 0.0f), _mm_set1_ps(Component(box.Extents, axis))), rows.Row[0], rows.Row[1], rows.Row[2], rows.Row[3]);
+
+		auto center = Simd::MultiplyRow(Load3(&box.Center.X, 1.0f), rows.Row[0], rows.Row[1], rows.Row[2], rows.Row[3]);
+
+		auto length0 = Simd::Dot3(halfAxes[0], halfAxes[0]);
+		auto axis0 = _mm_div_ps(halfAxes[0], _mm_sqrt_ps(length0));
+		auto axis1 = _mm_sub_ps(halfAxes[1], _mm_mul_ps(axis0, Simd::Dot3(axis0, halfAxes[1])));
+		auto length1 = Simd::Dot3(axis1, axis1);
+
+		if (_mm_cvtss_f32(_mm_min_ss(length0, length1)) <= _degenerateLength)
+		{
+			Vector3 vectors[3];
+
+			for (auto axis = 0; axis < 3; axis++)
+				Store3(&vectors[axis].X, halfAxes[axis]);
+
+			Store3(&result.Center.X, center);
+			FitBasis(vectors, result);
+			return;
+		}
+
+		axis1 = _mm_div_ps(axis1, _mm_sqrt_ps(length1));
+		auto axis2 = Simd::Cross(axis0, axis1);
+
+		auto extent0 = _mm_add_ps(_mm_add_ps(Absolute(Simd::Dot3(halfAxes[0], axis0)), Absolute(Simd::Dot3(halfAxes[1], axis0))), Absolute(Simd::Dot3(halfAxes[2], axis0)));
+		auto extent1 = _mm_add_ps(_mm_add_ps(Absolute(Simd::Dot3(halfAxes[0], axis1)), Absolute(Simd::Dot3(halfAxes[1], axis1))), Absolute(Simd::Dot3(halfAxes[2], axis1)));
+		auto extent2 = _mm_add_ps(_mm_add_ps(Absolute(Simd::Dot3(halfAxes[0], axis2)), Absolute(Simd::Dot3(halfAxes[1], axis2))), Absolute(Simd::Dot3(halfAxes[2], axis2)));
+
+		Store3(&result.Center.X, center);
+		Store3(&result.Extents.X, Simd::Shuffle<0, 2, 0, 0>(Simd::Shuffle<0, 0, 0, 0>(extent0, extent1), extent2));
+		Store3(&result.Axes.Item(0).X, axis0);
+		Store3(&result.Axes.Item(1).X, axis1);
+		Store3(&result.Axes.Item(2).X, axis2);
+	}
+#else
+	auto TransformAffine(const Matrix4x4& transform, Point3 point) -> Point3
+	{
+		auto& m = transform.Elements;
+
+		return
+		{
+			point.X * m.Item(0) + point.Y * m.Item(4) + point.Z * m.Item(8) + m.Item(12),
+			point.X * m.Item(1) + point.Y * m.Item(5) + point.Z * m.Item(9) + m.Item(13),
+			point.X * m.Item(2) + point.Y * m.Item(6) + point.Z * m.Item(10) + m.Item(14)
+		};
+	}
+
+	auto TransformAffine(const Matrix4x4& transform, Vector3 vector) -> Vector3
+	{
+		auto& m = transform.Elements;
+
+		return
+		{
+			vector.X * m.Item(0) + vector.Y * m.Item(4) + vector.Z * m.Item(8),
+			vector.X * m.Item(1) + vector.Y * m.Item(5) + vector.Z * m.Item(9),
+			vector.X * m.Item(2) + vector.Y * m.Item(6) + vector.Z * m.Item(10)
+		};
+	}
+
+	struct Rows
+	{
+		const Matrix4x4& Transform;
+
+		explicit Rows(const Matrix4x4& transform) :
+			Transform(transform)
+		{
+		}
+	};
+
+	void TransformBox(const Aabb3& bounds, const Rows& rows, Aabb3& result)
+	{
+		auto& m = rows.Transform.Elements;
+		auto center = TransformAffine(rows.Transform, bounds.GetCenter());
+		auto extents = bounds.GetExtents();
+
+		auto x = std::abs(m.Item(0)) * extents.X + std::abs(m.Item(4)) * extents.Y + std::abs(m.Item(8)) * extents.Z;
+		auto y = std::abs(m.Item(1)) * extents.X + std::abs(m.Item(5)) * extents.Y + std::abs(m.Item(9)) * extents.Z;
+		auto z = std::abs(m.Item(2)) * extents.X + std::abs(m.Item(6)) * extents.Y + std::abs(m.Item(10)) * extents.Z;
+
+		result = { { center.X - x, center.Y - y, center.Z - z }, { center.X + x, center.Y + y, center.Z + z } };
+	}
+
+	void TransformSphere(const BoundingSphere& sphere, const Rows& rows, BoundingSphere& result)
+	{
+		auto& m = rows.Transform.Elements;
+		float gram[3][3];
+
+		for (auto row = 0; row < 3; row++)
+		{
+			for (auto column = 0; column < 3; column++)
+				gram[row][column] = std::abs(m.Item(row * 4) * m.Item(column * 4) + m.Item(row * 4 + 1) * m.Item(column * 4 + 1) + m.Item(row * 4 + 2) * m.Item(column * 4 + 2));
+		}
+
+		auto scale = 0.0f;
+
+		for (auto row = 0; row < 3; row++)
+			scale = std::max(scale, gram[row][0] + gram[row][1] + gram[row][2]);
+
+		result = { TransformAffine(rows.Transform, sphere.Center), sphere.Radius * std::sqrt(scale) };
+	}
+
+	void TransformBox(const Obb& box, const Rows& rows, Obb& result)
+	{
+		Vector3 halfAxes[3];
+
+		for (auto axis = 0; axis < 3; axis++)
+			halfAxes[axis] = TransformAffine(rows.Transform, box.Axes.Item(axis) * Component(box.Extents, axis));
+
+		result.Center = TransformAffine(rows.Transform, box.Center);
+		FitBasis(halfAxes, result);
+	}
+#endif
+
+	void TransformBox(const Aabb2& bounds, const Matrix3x3& transform, Aabb2& result)
+	{
+		auto& m = transform.Elements;
+
+#if PARGON_MATH_SSE
+		auto value = _mm_loadu_ps(&bounds.Minimum.X);
+		auto swapped = Simd::Swizzle<2, 3, 0, 1>(value);
+		auto half = _mm_set1_ps(0.5f);
+
+		auto row0 = _mm_setr_ps(m.Item(0), m.Item(1), m.Item(0), m.Item(1));
+		auto row1 = _mm_setr_ps(m.Item(3), m.Item(4), m.Item(3), m.Item(4));
+		auto row2 = _mm_setr_ps(m.Item(6), m.Item(7), m.Item(6), m.Item(7));
+
+		auto center = _mm_mul_ps(_mm_add_ps(value, swapped), half);
+		auto extents = _mm_mul_ps(_mm_sub_ps(swapped, value), half);
+
+		center = Simd::MultiplyAdd(Simd::Splat<1>(center), row1, Simd::MultiplyAdd(Simd::Splat<0>(center), row0, row2));
+		extents = Simd::MultiplyAdd(Simd::Splat<1>(extents), Absolute(row1), _mm_mul_ps(Simd::Splat<0>(extents), Absolute(row0)));
+
+		_mm_storeu_ps(&result.Minimum.X, _mm_add_ps(center, _mm_xor_ps(extents, _mm_setr_ps(-0.0f, -0.0f, 0.0f, 0.0f))));
+#else
+		auto center = bounds.GetCenter();
+		auto extents = bounds.GetExtents();
+
+		auto x = center.X * m.Item(0) + center.Y * m.Item(3) + m.Item(6);
+		auto y = center.X * m.Item(1) + center.Y * m.Item(4) + m.Item(7);
+		auto extentX = std::abs(m.Item(0)) * extents.X + std::abs(m.Item(3)) * extents.Y;
+		auto extentY = std::abs(m.Item(1)) * extents.X + std::abs(m.Item(4)) * extents.Y;
+
+		result = { { x - extentX, y - extentY }, { x + extentX, y + extentY } };
+#endif
+	}
+
+	auto ContainsOffset(const Obb& box, Vector3 offset, float radius) -> bool
+	{
+		for (auto axis = 0; axis < 3; axis++)
+		{
+			if (std::abs(Dot(offset, box.Axes.Item(axis))) > Component(box.Extents, axis) + radius)
+				return false;
+		}
+
+		return true;
+	}
+}
+
+auto Aabb2::CreateFromPoints(const Point2* points, int count) -> Aabb2
+{
+	auto infinity = std::numeric_limits<float>::infinity();
+	auto minimumX = Simd::Wide::Broadcast(infinity), minimumY = minimumX;
+	auto maximumX = Simd::Wide::Broadcast(-infinity), maximumY = maximumX;
+
+	ForEachPointBlock(points, count, [&](Simd::Wide x, Simd::Wide y)
+	{
+		minimumX = Simd::Minimum(minimumX, x);
+		minimumY = Simd::Minimum(minimumY, y);
+		maximumX = Simd::Maximum(maximumX, x);
+		maximumY = Simd::Maximum(maximumY, y);
+	});
+
+	return { { ReduceMinimum(minimumX), ReduceMinimum(minimumY) }, { ReduceMaximum(maximumX), ReduceMaximum(maximumY) } };
+}
+
+auto Aabb2::GetCenter() const -> Point2
+{
+	return { (Minimum.X + Maximum.X) * 0.5f, (Minimum.Y + Maximum.Y) * 0.5f };
+}
+
+auto Aabb2::GetExtents() const -> Vector2
+{
+	return { (Maximum.X - Minimum.X) * 0.5f, (Maximum.Y - Minimum.Y) * 0.5f };
+}
+
+auto Aabb2::Contains(Point2 point) const -> bool
+{
+	return point.X >= Minimum.X && point.X <= Maximum.X && point.Y >= Minimum.Y && point.Y <= Maximum.Y;
+}
+
+auto Aabb2::Contains(const Aabb2& bounds) const -> bool
+{
+	return bounds.Minimum.X >= Minimum.X && bounds.Maximum.X <= Maximum.X && bounds.Minimum.Y >= Minimum.Y && bounds.Maximum.Y <= Maximum.Y;
+}
+
+auto Aabb2::Overlaps(const Aabb2& bounds) const -> bool
+{
+	return bounds.Minimum.X <= Maximum.X && bounds.Maximum.X >= Minimum.X && bounds.Minimum.Y <= Maximum.Y && bounds.Maximum.Y >= Minimum.Y;
+}
+
+void Aabb2::Merge(Point2 point)
+{
+	Minimum = { std::min(Minimum.X, point.X), std::min(Minimum.Y, point.Y) };
+	Maximum = { std::max(Maximum.X, point.X), std::max(Maximum.Y, point.Y) };
+}
+
+void Aabb2::Merge(const Aabb2& bounds)
+{
+	Minimum = { std::min(Minimum.X, bounds.Minimum.X), std::min(Minimum.Y, bounds.Minimum.Y) };
+	Maximum = { std::max(Maximum.X, bounds.Maximum.X), std::max(Maximum.Y, bounds.Maximum.Y) };
+}
+
+void Aabb2::Transform(const Matrix3x3& transform)
+{
+	if (!IsEmpty())
+		TransformBox(*this, transform, *this);
+}
+
+auto Aabb2::Merged(Point2 point) const -> Aabb2
+{
+	auto copy = *this;
+	copy.Merge(point);
+	return copy;
+}
+
+auto Aabb2::Merged(const Aabb2& bounds) const -> Aabb2
+{
+	auto copy = *this;
+	copy.Merge(bounds);
+	return copy;
+}
+
+auto Aabb2::Transformed(const Matrix3x3& transform) const -> Aabb2
+{
+	auto copy = *this;
+	copy.Transform(transform);
+	return copy;
+}
+
+void Aabb2::ToBuffer(BufferWriter& writer) const
+{
+	Minimum.ToBuffer(writer);
+	Maximum.ToBuffer(writer);
+}
+
+void Aabb2::FromBuffer(BufferReader& reader)
+{
+	Minimum.FromBuffer(reader);
+	Maximum.FromBuffer(reader);
+}
+
+void Aabb2::ToString(StringWriter& writer, StringView format) const
+{
+	writer.Format("{} {} {} {}", Minimum.X, Minimum.Y, Maximum.X, Maximum.Y);
+}
+
+void Aabb2::FromString(StringReader& reader, StringView format)
+{
+	if (!reader.Parse("{} {} {} {}", Minimum.X, Minimum.Y, Maximum.X, Maximum.Y))
+		reader.ReportError("the string could not be read as an Aabb2 (expected four floating point numbers separated by a space");
+}
+
+auto Aabb3::CreateFromPoints(const Point3* points, int count) -> Aabb3
+{
+	return GetBounds([&](auto block) { ForEachPointBlock(points, count, block); });
+}
+
+auto Aabb3::CreateFromPoints(const Point3Stream& points) -> Aabb3
+{
+	return GetBounds([&](auto block) { ForEachPointBlock(points, block); });
+}
+
+auto Aabb3::GetCenter() const -> Point3
+{
+	return { (Minimum.X + Maximum.X) * 0.5f, (Minimum.Y + Maximum.Y) * 0.5f, (Minimum.Z + Maximum.Z) * 0.5f };
+}
+
+auto Aabb3::GetExtents() const -> Vector3
+{
+	return { (Maximum.X - Minimum.X) * 0.5f, (Maximum.Y - Minimum.Y) * 0.5f, (Maximum.Z - Minimum.Z) * 0.5f };
+}
+
+auto Aabb3::Contains(Point3 point) const -> bool
+{
+	return point.X >= Minimum.X && point.X <= Maximum.X && point.Y >= Minimum.Y && point.Y <= Maximum.Y && point.Z >= Minimum.Z && point.Z <= Maximum.Z;
+}
+
+auto Aabb3::Contains(const Aabb3& bounds) const -> bool
+{
+	return Contains(bounds.Minimum) && Contains(bounds.Maximum);
+}
+
+auto Aabb3::Overlaps(const Aabb3& bounds) const -> bool
+{
+	return bounds.Minimum.X <= Maximum.X && bounds.Maximum.X >= Minimum.X && bounds.Minimum.Y <= Maximum.Y && bounds.Maximum.Y >= Minimum.Y && bounds.Minimum.Z <= Maximum.Z && bounds.Maximum.Z >= Minimum.Z;
+}
+
+void Aabb3::Merge(Point3 point)
+{
+	Minimum = { std::min(Minimum.X, point.X), std::min(Minimum.Y, point.Y), std::min(Minimum.Z, point.Z) };
+	Maximum = { std::max(Maximum.X, point.X), std::max(Maximum.Y, point.Y), std::max(Maximum.Z, point.Z) };
+}
+
+void Aabb3::Merge(const Aabb3& bounds)
+{
+	Minimum = { std::min(Minimum.X, bounds.Minimum.X), std::min(Minimum.Y, bounds.Minimum.Y), std::min(Minimum.Z, bounds.Minimum.Z) };
+	Maximum = { std::max(Maximum.X, bounds.Maximum.X), std::max(Maximum.Y, bounds.Maximum.Y), std::max(Maximum.Z, bounds.Maximum.Z) };
+}
+
+void Aabb3::Transform(const Matrix4x4& transform)
+{
+	if (!IsEmpty())
+		TransformBox(*this, Rows(transform), *this);
+}
+
+auto Aabb3::Merged(Point3 point) const -> Aabb3
+{
+	auto copy = *this;
+	copy.Merge(point);
+	return copy;
+}
+
+auto Aabb3::Merged(const Aabb3& bounds) const -> Aabb3
+{
+	auto copy = *this;
+	copy.Merge(bounds);
+	return copy;
+}
+
+auto Aabb3::Transformed(const Matrix4x4& transform) const -> Aabb3
+{
+	auto copy = *this;
+	copy.Transform(transform);
+	return copy;
+}
+
+void Aabb3::ToBuffer(BufferWriter& writer) const
+{
+	Minimum.ToBuffer(writer);
+	Maximum.ToBuffer(writer);
+}
+
+void Aabb3::FromBuffer(BufferReader& reader)
+{
+	Minimum.FromBuffer(reader);
+	Maximum.FromBuffer(reader);
+}
+
+void Aabb3::ToString(StringWriter& writer, StringView format) const
+{
+	writer.Format("{} {} {} {} {} {}", Minimum.X, Minimum.Y, Minimum.Z, Maximum.X, Maximum.Y, Maximum.Z);
+}
+
+void Aabb3::FromString(StringReader& reader, StringView format)
+{
+	if (!reader.Parse("{} {} {} {} {} {}", Minimum.X, Minimum.Y, Minimum.Z, Maximum.X, Maximum.Y, Maximum.Z))
+		reader.ReportError("the string could not be read as an Aabb3 (expected six floating point numbers separated by a space");
+}
+
+auto BoundingSphere::CreateFromPoints(const Point3* points, int count) -> BoundingSphere
+{
+	assert(count > 0);
+	return GetSphere([&](auto block) { ForEachPointBlock(points, count, block); });
+}
+
+auto BoundingSphere::CreateFromPoints(const Point3Stream& points) -> BoundingSphere
+{
+	assert(points.Count() > 0);
+	return GetSphere([&](auto block) { ForEachPointBlock(points, block); });
+}
+
+auto BoundingSphere::Contains(Point3 point) const -> bool
+{
+	return (point - Center).GetLengthSquared() <= Radius * Radius;
+}
+
+auto BoundingSphere::Contains(const BoundingSphere& sphere) const -> bool
+{
+	return sphere.Radius <= Radius && (sphere.Center - Center).GetLengthSquared() <= (Radius - sphere.Radius) * (Radius - sphere.Radius);
+}
+
+auto BoundingSphere::Overlaps(const BoundingSphere& sphere) const -> bool
+{
+	return (sphere.Center - Center).GetLengthSquared() <= (Radius + sphere.Radius) * (Radius + sphere.Radius);
+}
+
+auto BoundingSphere::Overlaps(const Aabb3& bounds) const -> bool
+{
+	auto x = std::clamp(Center.X, bounds.Minimum.X, bounds.Maximum.X);
+	auto y = std::clamp(Center.Y, bounds.Minimum.Y, bounds.Maximum.Y);
+	auto z = std::clamp(Center.Z, bounds.Minimum.Z, bounds.Maximum.Z);
+
+	return (Point3{ x, y, z } - Center).GetLengthSquared() <= Radius * Radius;
+}
+
+void BoundingSphere::Merge(Point3 point)
+{
+	Merge({ point, 0.0f });
+}
+
+void BoundingSphere::Merge(const BoundingSphere& sphere)
+{
+	auto offset = sphere.Center - Center;
+	auto distance = offset.GetLength();
+
+	if (distance + sphere.Radius <= Radius)
+		return;
+
+	if (distance + Radius <= sphere.Radius)
+	{
+		*this = sphere;
+		return;
+	}
+
+	auto radius = (distance + Radius + sphere.Radius) * 0.5f;
+	Center += offset * ((radius - Radius) / distance);
+	Radius = radius;
+}
+
+void BoundingSphere::Transform(const Matrix4x4& transform)
+{
+	TransformSphere(*this, Rows(transform), *this);
+}
+
+auto BoundingSphere::Merged(Point3 point) const -> BoundingSphere
+{
+	auto copy = *this;
+	copy.Merge(point);
+	return copy;
+}
+
+auto BoundingSphere::Merged(const BoundingSphere& sphere) const -> BoundingSphere
+{
+	auto copy = *this;
+	copy.Merge(sphere);
+	return copy;
+}
+
+auto BoundingSphere::Transformed(const Matrix4x4& transform) const -> BoundingSphere
+{
+	auto copy = *this;
+	copy.Transform(transform);
+	return copy;
+}
+
+void BoundingSphere::ToBuffer(BufferWriter& writer) const
+{
+	Center.ToBuffer(writer);
+	writer.Write(Radius);
+}
+
+void BoundingSphere::FromBuffer(BufferReader& reader)
+{
+	Center.FromBuffer(reader);
+	reader.Read(Radius);
+}
+
+void BoundingSphere::ToString(StringWriter& writer, StringView format) const
+{
+	writer.Format("{} {} {} {}", Center.X, Center.Y, Center.Z, Radius);
+}
+
+void BoundingSphere::FromString(StringReader& reader, StringView format)
+{
+	if (!reader.Parse("{} {} {} {}", Center.X, Center.Y, Center.Z, Radius))
+		reader.ReportError("the string could not be read as a BoundingSphere (expected four floating point numbers separated by a space");
+}
+
+auto Obb::CreateFromPoints(const Point3* points, int count) -> Obb
+{
+	return GetBox([&](auto block) { ForEachPointBlock(points, count, block); }, count, [&](int index) { return points[index]; });
+}
+
+auto Obb::CreateFromPoints(const Point3Stream& points) -> Obb
+{
+	return GetBox([&](auto block) { ForEachPointBlock(points, block); }, points.Count(), [&](int index) { return Point3{ points.GetX()[index], points.GetY()[index], points.GetZ()[index] }; });
+}
+
+auto Obb::CreateFromAabb(const Aabb3& bounds, const Matrix4x4& transform) -> Obb
+{
+	Obb box = { bounds.GetCenter(), bounds.GetExtents(), {{ { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } }} };
+	box.Transform(transform);
+	return box;
+}
+
+auto Obb::GetBounds() const -> Aabb3
+{
+	auto& axes = Axes;
+	auto x = std::abs(axes.Item(0).X) * Extents.X + std::abs(axes.Item(1).X) * Extents.Y + std::abs(axes.Item(2).X) * Extents.Z;
+	auto y = std::abs(axes.Item(0).Y) * Extents.X + std::abs(axes.Item(1).Y) * Extents.Y + std::abs(axes.Item(2).Y) * Extents.Z;
+	auto z = std::abs(axes.Item(0).Z) * Extents.X + std::abs(axes.Item(1).Z) * Extents.Y + std::abs(axes.Item(2).Z) * Extents.Z;
+
+	return { { Center.X - x, Center.Y - y, Center.Z - z }, { Center.X + x, Center.Y + y, Center.Z + z } };
+}
+
+auto Obb::Contains(Point3 point) const -> bool
+{
+	return ContainsOffset(*this, point - Center, 0.0f);
+}
+
+auto Obb::Overlaps(const Obb& box) const -> bool
+{
+	// Separating axis test from Real-Time Collision Detection (Ericson, 4.4.1) with the other box in the space of
+	// this one. The epsilon keeps the cross product axes from reporting false separation when edges are parallel.
+
+	float rotation[3][3];
+	float absolute[3][3];
+
+	for (auto row = 0; row < 3; row++)
+	{
+		for (auto column = 0; column < 3; column++)
+		{
+			rotation[row][column] = Dot(Axes.Item(row), box.Axes.Item(column));
+			absolute[row][column] = std::abs(rotation[row][column]) + _parallelEpsilon;
+		}
+	}
+
+	auto offset = box.Center - Center;
+	float translation[3] = { Dot(offset, Axes.Item(0)), Dot(offset, Axes.Item(1)), Dot(offset, Axes.Item(2)) };
+	float extents[3] = { Extents.X, Extents.Y, Extents.Z };
+	float otherExtents[3] = { box.Extents.X, box.Extents.Y, box.Extents.Z };
+
+	for (auto axis = 0; axis < 3; axis++)
+	{
+		auto other = otherExtents[0] * absolute[axis][0] + otherExtents[1] * absolute[axis][1] + otherExtents[2] * absolute[axis][2];
+
+		if (std::abs(translation[axis]) > extents[axis] + other)
+			return false;
+	}
+
+	for (auto axis = 0; axis < 3; axis++)
+	{
+		auto self = extents[0] * absolute[0][axis] + extents[1] * absolute[1][axis] + extents[2] * absolute[2][axis];
+		auto distance = translation[0] * rotation[0][axis] + translation[1] * rotation[1][axis] + translation[2] * rotation[2][axis];
+
+		if (std::abs(distance) > self + otherExtents[axis])
+			return false;
+	}
+
+	for (auto i = 0; i < 3; i++)
+	{
+		auto i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+
+		for (auto j = 0; j < 3; j++)
+		{
+			auto j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+
+			auto self = extents[i1] * absolute[i2][j] + extents[i2] * absolute[i1][j];
+			auto other = otherExtents[j1] * absolute[i][j2] + otherExtents[j2] * absolute[i][j1];
+			auto distance = translation[i2] * rotation[i1][j] - translation[i1] * rotation[i2][j];
+
+			if (std::abs(distance) > self + other)
+				return false;
+		}
+	}
+
+	return true;
+}
+
+void Obb::Merge(Point3 point)
+{
+	auto offset = point - Center;
+	auto center = Vector3{ 0.0f, 0.0f, 0.0f };
+
+	for (auto axis = 0; axis < 3; axis++)
+	{
+		auto projection = Dot(offset, Axes.Item(axis));
+		auto extent = Component(Extents, axis);
+		auto low = std::min(-extent, projection);
+		auto high = std::max(extent, projection);
+
+		SetComponent(Extents, axis, (high - low) * 0.5f);
+		center += Axes.Item(axis) * ((high + low) * 0.5f);
+	}
+
+	Center += center;
+}
+
+void Obb::Merge(const Obb& box)
+{
+	auto offset = box.Center - Center;
+	auto center = Vector3{ 0.0f, 0.0f, 0.0f };
+
+	for (auto axis = 0; axis < 3; axis++)
+	{
+		auto& direction = Axes.Item(axis);
+		auto projection = Dot(offset, direction);
+		auto radius = box.Extents.X * std::abs(Dot(box.Axes.Item(0), direction)) + box.Extents.Y * std::abs(Dot(box.Axes.Item(1), direction)) + box.Extents.Z * std::abs(Dot(box.Axes.Item(2), direction));
+		auto extent = Component(Extents, axis);
+		auto low = std::min(-extent, projection - radius);
+		auto high = std::max(extent, projection + radius);
+
+		SetComponent(Extents, axis, (high - low) * 0.5f);
+		center += direction * ((high + low) * 0.5f);
+	}
+
+	Center += center;
+}
+
+void Obb::Transform(const Matrix4x4& transform)
+{
+	TransformBox(*this, Rows(transform), *this);
+}
+
+auto Obb::Merged(Point3 point) const -> Obb
+{
+	auto copy = *this;
+	copy.Merge(point);
+	return copy;
+}
+
+auto Obb::Merged(const Obb& box) const -> Obb
+{
+	auto copy = *this;
+	copy.Merge(box);
+	return copy;
+}
+
+auto Obb::Transformed(const Matrix4x4& transform) const -> Obb
+{
+	auto copy = *this;
+	copy.Transform(transform);
+	return copy;
+}
+
+void Obb::ToBuffer(BufferWriter& writer) const
+{
+	Center.ToBuffer(writer);
+	Extents.ToBuffer(writer);
+
+	for (auto& axis : Axes)
+		axis.ToBuffer(writer);
+}
+
+void Obb::FromBuffer(BufferReader& reader)
+{
+	Center.FromBuffer(reader);
+	Extents.FromBuffer(reader);
+
+	for (auto& axis : Axes)
+		axis.FromBuffer(reader);
+}
+
+void Obb::ToString(StringWriter& writer, StringView format) const
+{
+	auto& a = Axes;
+	writer.Format("{} {} {} {} {} {} {} {} {} {} {} {} {} {} {}", Center.X, Center.Y, Center.Z, Extents.X, Extents.Y, Extents.Z, a.Item(0).X, a.Item(0).Y, a.Item(0).Z, a.Item(1).X, a.Item(1).Y, a.Item(1).Z, a.Item(2).X, a.Item(2).Y, a.Item(2).Z);
+}
+
+void Obb::FromString(StringReader& reader, StringView format)
+{
+	auto& a = Axes;
+
+	if (!reader.Parse("{} {} {} {} {} {} {} {} {} {} {} {} {} {} {}", Center.X, Center.Y, Center.Z, Extents.X, Extents.Y, Extents.Z, a.Item(0).X, a.Item(0).Y, a.Item(0).Z, a.Item(1).X, a.Item(1).Y, a.Item(1).Z, a.Item(2).X, a.Item(2).Y, a.Item(2).Z))
+		reader.ReportError("the string could not be read as an Obb (expected fifteen floating point numbers separated by a space");
+}
+
+void Pargon::TransformBounds(const Aabb2* bounds, int count, const Matrix3x3& transform, Aabb2* results)
+{
+	for (auto index = 0; index < count; index++)
+	{
+		if (bounds[index].IsEmpty())
+			results[index] = bounds[index];
+		else
+			TransformBox(bounds[index], transform, results[index]);
+	}
+}
+
+void Pargon::TransformBounds(const Aabb2* bounds, const Matrix3x3* transforms, int count, Aabb2* results)
+{
+	for (auto index = 0; index < count; index++)
+	{
+		if (bounds[index].IsEmpty())
+			results[index] = bounds[index];
+		else
+			TransformBox(bounds[index], transforms[index], results[index]);
+	}
+}
+
+void Pargon::TransformBounds(const Aabb3* bounds, int count, const Matrix4x4& transform, Aabb3* results)
+{
+	auto rows = Rows(transform);
+
+	for (auto index = 0; index < count; index++)
+	{
+		if (bounds[index].IsEmpty())
+			results[index] = bounds[index];
+		else
+			TransformBox(bounds[index], rows, results[index]);
+	}
+}
+
+void Pargon::TransformBounds(const Aabb3* bounds, const Matrix4x4* transforms, int count, Aabb3* results)
+{
+	for (auto index = 0; index < count; index++)
+	{
+		if (bounds[index].IsEmpty())
+			results[index] = bounds[index];
+		else
+			TransformBox(bounds[index], Rows(transforms[index]), results[index]);
+	}
+}
+
+void Pargon::TransformBounds(const BoundingSphere* spheres, int count, const Matrix4x4& transform, BoundingSphere* results)
+{
+	auto rows = Rows(transform);
+
+	for (auto index = 0; index < count; index++)
+		TransformSphere(spheres[index], rows, results[index]);
+}
+
+void Pargon::TransformBounds(const BoundingSphere* spheres, const Matrix4x4* transforms, int count, BoundingSphere* results)
+{
+	for (auto index = 0; index < count; index++)
+		TransformSphere(spheres[index], Rows(transforms[index]), results[index]);
+}
+
+void Pargon::TransformBounds(const Obb* boxes, int count, const Matrix4x4& transform, Obb* results)
+{
+	auto rows = Rows(transform);
+
+	for (auto index = 0; index < count; index++)
+		TransformBox(boxes[index], rows, results[index]);
+}
+
+void Pargon::TransformBounds(const Obb* boxes, const Matrix4x4* transforms, int count, Obb* results)
+{
+	for (auto index = 0; index < count; index++)
+		TransformBox(boxes[index], Rows(transforms[index]), results[index]);
+}
+
+auto Pargon::MergeBounds(const Aabb2* bounds, int count) -> Aabb2
+{
+#if PARGON_MATH_SSE
+	// Negating the minimum lets a single maximum merge both corners.
+
+	auto result = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+	auto signs = _mm_setr_ps(-0.0f, -0.0f, 0.0f, 0.0f);
+
+	for (auto index = 0; index < count; index++)
+		result = _mm_max_ps(result, _mm_xor_ps(_mm_loadu_ps(&bounds[index].Minimum.X), signs));
+
+	Aabb2 merged;
+	_mm_storeu_ps(&merged.Minimum.X, _mm_xor_ps(result, signs));
+	return merged;
+#else
+	auto merged = Aabb2::CreateEmpty();
+
+	for (auto index = 0; index < count; index++)
+		merged.Merge(bounds[index]);
+
+	return merged;
+#endif
+}
+
+auto Pargon::MergeBounds(const Aabb3* bounds, int count) -> Aabb3
+{
+#if PARGON_MATH_SSE
+	auto infinity = std::numeric_limits<float>::infinity();
+	auto minimum = _mm_set1_ps(infinity);
+	auto maximum = _mm_set1_ps(-infinity);
+
+	for (auto index = 0; index < count; index++)
+	{
+		minimum = _mm_min_ps(minimum, Load3(&bounds[index].Minimum.X, infinity));
+		maximum = _mm_max_ps(maximum, Load3(&bounds[index].Maximum.X, -infinity));
+	}
+
+	Aabb3 merged;
+	Store3(&merged.Minimum.X, minimum);
+	Store3(&merged.Maximum.X, maximum);
+	return merged;
+#else
+	auto merged = Aabb3::CreateEmpty();
+
+	for (auto index = 0; index < count; index++)
+		merged.Merge(bounds[index]);
+
+	return merged;
+#endif
+}
+
+auto Pargon::MergeBounds(const BoundingSphere* spheres, int count) -> BoundingSphere
+{
+	// Like CreateFromPoints this centers the result on the bounding box of the spheres rather than merging them one
+	// at a time, which keeps both passes independent of order.
+
+	assert(count > 0);
+
+	auto bounds = Aabb3::CreateEmpty();
+	auto farthest = 0.0f;
+
+#if PARGON_MATH_SSE
+	auto minimum = _mm_set1_ps(std::numeric_limits<float>::infinity());
+	auto maximum = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+
+	for (auto index = 0; index < count; index++)
+	{
+		auto value = _mm_load_ps(&spheres[index].Center.X);
+		auto radius = Simd::Splat<3>(value);
+
+		minimum = _mm_min_ps(minimum, _mm_sub_ps(value, radius));
+		maximum = _mm_max_ps(maximum, _mm_add_ps(value, radius));
+	}
+
+	Store3(&bounds.Minimum.X, minimum);
+	Store3(&bounds.Maximum.X, maximum);
+
+	auto middle = bounds.GetCenter();
+	auto center = Load3(&middle.X, 0.0f);
+	auto distance = _mm_setzero_ps();
+
+	for (auto index = 0; index < count; index++)
+	{
+		auto value = _mm_load_ps(&spheres[index].Center.X);
+		auto offset = _mm_sub_ps(value, center);
+
+		distance = _mm_max_ss(distance, _mm_add_ss(_mm_sqrt_ss(Simd::Dot3(offset, offset)), Simd::Splat<3>(value)));
+	}
+
+	farthest = _mm_cvtss_f32(distance);
+#else
+	for (auto index = 0; index < count; index++)
+	{
+		auto& sphere = spheres[index];
+		bounds.Merge(Aabb3{ sphere.Center - Vector3{ sphere.Radius, sphere.Radius, sphere.Radius }, sphere.Center + Vector3{ sphere.Radius, sphere.Radius, sphere.Radius } });
+	}
+
+	for (auto index = 0; index < count; index++)
+		farthest = std::max(farthest, (spheres[index].Center - bounds.GetCenter()).GetLength() + spheres[index].Radius);
+#endif
+
+	return { bounds.GetCenter(), farthest };
+}
+
+void Pargon::TestOverlaps(const Aabb2& bounds, const Aabb2* others, int count, std::uint32_t* overlaps)
+{
+	std::fill(overlaps, overlaps + (count + 31) / 32, 0u);
+
+#if PARGON_MATH_SSE
+	// Each other box overlaps when its minimum is below the maximum and its maximum is above the minimum, so flipping
+	// the sign of the maximum half turns all four comparisons into less than or equal.
+
+	auto signs = _mm_setr_ps(0.0f, 0.0f, -0.0f, -0.0f);
+	auto limits = _mm_xor_ps(Simd::Swizzle<2, 3, 0, 1>(_mm_loadu_ps(&bounds.Minimum.X)), signs);
+
+	for (auto index = 0; index < count; index++)
+	{
+		auto inside = _mm_cmple_ps(_mm_xor_ps(_mm_loadu_ps(&others[index].Minimum.X), signs), limits);
+
+		if (_mm_movemask_ps(inside) == 0xF)
+			overlaps[index / 32] |= 1u << (index % 32);
+	}
+#else
+	for (auto index = 0; index < count; index++)
+	{
+		if (bounds.Overlaps(others[index]))
+			overlaps[index / 32] |= 1u << (index % 32);
+	}
+#endif
+}
+
+void Pargon::TestOverlaps(const Aabb3& bounds, const Aabb3* others, int count, std::uint32_t* overlaps)
+{
+	std::fill(overlaps, overlaps + (count + 31) / 32, 0u);
+
+#if PARGON_MATH_SSE
+	auto minimum = Load3(&bounds.Minimum.X, 0.0f);
+	auto maximum = Load3(&bounds.Maximum.X, 0.0f);
+
+	for (auto index = 0; index < count; index++)
+	{
+		auto inside = _mm_and_ps(_mm_cmple_ps(Load3(&others[index].Minimum.X, 0.0f), maximum), _mm_cmpge_ps(Load3(&others[index].Maximum.X, 0.0f), minimum));
+
+		if (_mm_movemask_ps(inside) == 0xF)
+			overlaps[index / 32] |= 1u << (index % 32);
+	}
+#else
+	for (auto index = 0; index < count; index++)
+	{
+		if (bounds.Overlaps(others[index]))
+			overlaps[index / 32] |= 1u << (index % 32);
+	}
+#endif
+}
+
+void Pargon::TestOverlaps(const BoundingSphere& sphere, const BoundingSphere* others, int count, std::uint32_t* overlaps)
+{
+	std::fill(overlaps, overlaps + (count + 31) / 32, 0u);
+
+	auto index = 0;
+
+#if PARGON_MATH_SSE
+	auto centerX = _mm_set1_ps(sphere.Center.X), centerY = _mm_set1_ps(sphere.Center.Y), centerZ = _mm_set1_ps(sphere.Center.Z);
+	auto radius = _mm_set1_ps(sphere.Radius);
+
+	for (; index + 4 <= count; index += 4)
+	{
+		auto x = _mm_load_ps(&others[index + 0].Center.X);
+		auto y = _mm_load_ps(&others[index + 1].Center.X);
+		auto z = _mm_load_ps(&others[index + 2].Center.X);
+		auto radii = _mm_load_ps(&others[index + 3].Center.X);
+		_MM_TRANSPOSE4_PS(x, y, z, radii);
+
+		auto offsetX = _mm_sub_ps(x, centerX), offsetY = _mm_sub_ps(y, centerY), offsetZ = _mm_sub_ps(z, centerZ);
+		auto distance = Simd::MultiplyAdd(offsetZ, offsetZ, Simd::MultiplyAdd(offsetY, offsetY, _mm_mul_ps(offsetX, offsetX)));
+		auto limit = _mm_add_ps(radii, radius);
+
+		overlaps[index / 32] |= static_cast<std::uint32_t>(_mm_movemask_ps(_mm_cmple_ps(distance, _mm_mul_ps(limit, limit)))) << (index % 32);
+	}
+#endif
+
+	for (; index < count; index++)
+	{
+		if (sphere.Overlaps(others[index]))
+			overlaps[index / 32] |= 1u << (index % 32);
+	}
+}
+
+void Pargon::TestOverlaps(const Obb& box, const Obb* others, int count, std::uint32_t* overlaps)
+{
+	std::fill(overlaps, overlaps + (count + 31) / 32, 0u);
+
+	// Boxes whose bounding spheres do not touch are rejected before running the full separating axis test.
+
+	auto radius = box.Extents.GetLength();
+
+	for (auto index = 0; index < count; index++)
+	{
+		auto& other = others[index];
+		auto limit = radius + other.Extents.GetLength();
+
+		if ((other.Center - box.Center).GetLengthSquared() <= limit * limit && box.Overlaps(other))
+			overlaps[index / 32] |= 1u << (index % 32);
+	}
+}
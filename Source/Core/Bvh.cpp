@@ -0,0 +1,932 @@
+#include "Pargon/Math/Bvh.h"
+#include "Pargon/Serialization/BufferReader.h"
+#include "Pargon/Serialization/BufferWriter.h"
+#include "Core/Simd.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+using namespace Pargon;
+
+static_assert(sizeof(Bvh::Node) == 32, "Bvh::Node is expected to fill half a cache line");
+
+namespace
+{
+	constexpr int _binCount = 16;
+	constexpr int _maximumDepth = 64;
+	constexpr int _stackSize = 1024;
+	constexpr int _readChunkSize = 4096;
+
+	struct Bin
+	{
+		Aabb3 Bounds;
+		int Count;
+	};
+
+	struct StackEntry
+	{
+		int Child;
+		int Count;
+		float Near;
+	};
+
+	struct BuildNode
+	{
+		Aabb3 Bounds;
+		int Start;
+		int Count;
+		int Depth;
+		int Left;
+		int Right;
+		int Task;
+	};
+
+	struct BuildPrimitive
+	{
+		Aabb3 Bounds;
+		int Index;
+	};
+
+	struct BuildTaskData
+	{
+		int Root;
+		std::vector<BuildNode> Nodes;
+	};
+
+	auto GetSurfaceArea(const Aabb3& bounds) -> float
+	{
+		auto size = bounds.Maximum - bounds.Minimum;
+		return size.X * size.Y + size.Y * size.Z + size.Z * size.X;
+	}
+
+	auto Component(Point3 point, int axis) -> float
+	{
+		return axis == 0 ? point.X : (axis == 1 ? point.Y : point.Z);
+	}
+
+	// Centroids are left at twice their value since only their relative positions matter for binning.
+
+	auto GetCentroid(const Aabb3& bounds) -> Point3
+	{
+		return { bounds.Minimum.X + bounds.Maximum.X, bounds.Minimum.Y + bounds.Maximum.Y, bounds.Minimum.Z + bounds.Maximum.Z };
+	}
+
+	auto GetBin(float value, float low, float scale) -> int
+	{
+		return std::min(static_cast<int>((value - low) * scale), _binCount - 1);
+	}
+
+	void Grow(Aabb3& bounds, Point3 point)
+	{
+		bounds.Minimum = { std::min(bounds.Minimum.X, point.X), std::min(bounds.Minimum.Y, point.Y), std::min(bounds.Minimum.Z, point.Z) };
+		bounds.Maximum = { std::max(bounds.Maximum.X, point.X), std::max(bounds.Maximum.Y, point.Y), std::max(bounds.Maximum.Z, point.Z) };
+	}
+
+	void Grow(Aabb3& bounds, const Aabb3& other)
+	{
+		bounds.Minimum = { std::min(bounds.Minimum.X, other.Minimum.X), std::min(bounds.Minimum.Y, other.Minimum.Y), std::min(bounds.Minimum.Z, other.Minimum.Z) };
+		bounds.Maximum = { std::max(bounds.Maximum.X, other.Maximum.X), std::max(bounds.Maximum.Y, other.Maximum.Y), std::max(bounds.Maximum.Z, other.Maximum.Z) };
+	}
+
+	auto IntersectBox(const Aabb3& bounds, Point3 origin, Vector3 inverse, float distance, float& near) -> bool
+	{
+		auto x1 = (bounds.Minimum.X - origin.X) * inverse.X, x2 = (bounds.Maximum.X - origin.X) * inverse.X;
+		auto y1 = (bounds.Minimum.Y - origin.Y) * inverse.Y, y2 = (bounds.Maximum.Y - origin.Y) * inverse.Y;
+		auto z1 = (bounds.Minimum.Z - origin.Z) * inverse.Z, z2 = (bounds.Maximum.Z - origin.Z) * inverse.Z;
+
+		near = std::max(std::max(std::min(x1, x2), std::min(y1, y2)), std::max(std::min(z1, z2), 0.0f));
+		auto far = std::min(std::min(std::max(x1, x2), std::max(y1, y2)), std::min(std::max(z1, z2), distance));
+
+		return near <= far;
+	}
+
+	template<int Width>
+	void SetChild(Bvh::WideNode<Width>& node, int slot, const Aabb3& bounds, int child, int count)
+	{
+		node.MinimumX[slot] = bounds.Minimum.X;
+		node.MinimumY[slot] = bounds.Minimum.Y;
+		node.MinimumZ[slot] = bounds.Minimum.Z;
+		node.MaximumX[slot] = bounds.Maximum.X;
+		node.MaximumY[slot] = bounds.Maximum.Y;
+		node.MaximumZ[slot] = bounds.Maximum.Z;
+		node.Child[slot] = child;
+		node.Count[slot] = count;
+	}
+
+	// Repeatedly opens the interior child with the largest surface area until the node is full, so the wide tree
+	// keeps the SAH ordering of the binary one.
+	template<int Width>
+	auto CollapseNode(const std::vector<Bvh::Node>& nodes, int index, std::vector<Bvh::WideNode<Width>>& wideNodes) -> int
+	{
+		int children[Width];
+		auto childCount = 0;
+
+		if (nodes[index].Count > 0)
+		{
+			children[childCount++] = index;
+		}
+		else
+		{
+			children[childCount++] = index + 1;
+			children[childCount++] = nodes[index].Offset;
+		}
+
+		while (childCount < Width)
+		{
+			auto best = -1;
+			auto bestArea = -1.0f;
+
+			for (auto child = 0; child < childCount; child++)
+			{
+				auto& node = nodes[children[child]];
+
+				if (node.Count == 0 && GetSurfaceArea(node.Bounds) > bestArea)
+				{
+					best = child;
+					bestArea = GetSurfaceArea(node.Bounds);
+				}
+			}
+
+			if (best < 0)
+				break;
+
+			auto opened = children[best];
+			children[best] = opened + 1;
+			children[childCount++] = nodes[opened].Offset;
+		}
+
+		auto result = static_cast<int>(wideNodes.size());
+		wideNodes.emplace_back();
+
+		for (auto slot = 0; slot < Width; slot++)
+		{
+			if (slot >= childCount)
+			{
+				SetChild(wideNodes[result], slot, Aabb3::CreateEmpty(), 0, -1);
+			}
+			else if (nodes[children[slot]].Count > 0)
+			{
+				auto& node = nodes[children[slot]];
+				SetChild(wideNodes[result], slot, node.Bounds, node.Offset, node.Count);
+			}
+			else
+			{
+				auto child = CollapseNode(nodes, children[slot], wideNodes);
+				SetChild(wideNodes[result], slot, nodes[children[slot]].Bounds, child, 0);
+			}
+		}
+
+		return result;
+	}
+
+	// A 4 wide node under AVX fills the low half of a register and the upper lanes are masked off afterwards.
+	template<int Width>
+	auto LoadLanes(const float* data, int lane) -> Simd::Wide
+	{
+#if PARGON_MATH_AVX
+		if constexpr (Width < Simd::Wide::Width)
+			return { _mm256_castps128_ps256(_mm_loadu_ps(data)) };
+#endif
+		return Simd::Wide::LoadUnaligned(data + lane);
+	}
+
+	template<int Width>
+	auto IntersectChildren(const Bvh::WideNode<Width>& node, const Simd::Wide (&origin)[3], const Simd::Wide (&inverse)[3], float distance, float (&near)[Width]) -> unsigned
+	{
+		constexpr auto step = std::min(Width, Simd::Wide::Width);
+
+		auto mask = 0u;
+		auto zero = Simd::Wide::Broadcast(0.0f);
+		auto limit = Simd::Wide::Broadcast(distance);
+
+		for (auto lane = 0; lane < Width; lane += step)
+		{
+			auto x1 = (LoadLanes<Width>(node.MinimumX, lane) - origin[0]) * inverse[0], x2 = (LoadLanes<Width>(node.MaximumX, lane) - origin[0]) * inverse[0];
+			auto y1 = (LoadLanes<Width>(node.MinimumY, lane) - origin[1]) * inverse[1], y2 = (LoadLanes<Width>(node.MaximumY, lane) - origin[1]) * inverse[1];
+			auto z1 = (LoadLanes<Width>(node.MinimumZ, lane) - origin[2]) * inverse[2], z2 = (LoadLanes<Width>(node.MaximumZ, lane) - origin[2]) * inverse[2];
+
+			auto nearest = Simd::Maximum(Simd::Maximum(Simd::Minimum(x1, x2), Simd::Minimum(y1, y2)), Simd::Maximum(Simd::Minimum(z1, z2), zero));
+			auto farthest = Simd::Minimum(Simd::Minimum(Simd::Maximum(x1, x2), Simd::Maximum(y1, y2)), Simd::Minimum(Simd::Maximum(z1, z2), limit));
+
+			alignas(32) float values[Simd::Wide::Width];
+			nearest.Store(values);
+			std::copy(values, values + step, near + lane);
+
+			mask |= static_cast<unsigned>(Simd::MoveMask(Simd::LessThanOrEqual(nearest, farthest))) << lane;
+		}
+
+		return mask & ((1u << Width) - 1);
+	}
+
+	template<int Width>
+	auto OverlapChildren(const Bvh::WideNode<Width>& node, const Simd::Wide (&minimum)[3], const Simd::Wide (&maximum)[3]) -> unsigned
+	{
+		constexpr auto step = std::min(Width, Simd::Wide::Width);
+
+		auto mask = 0u;
+
+		for (auto lane = 0; lane < Width; lane += step)
+		{
+			auto overlapX = Simd::LessThanOrEqual(LoadLanes<Width>(node.MinimumX, lane), maximum[0]) & Simd::GreaterThanOrEqual(LoadLanes<Width>(node.MaximumX, lane), minimum[0]);
+			auto overlapY = Simd::LessThanOrEqual(LoadLanes<Width>(node.MinimumY, lane), maximum[1]) & Simd::GreaterThanOrEqual(LoadLanes<Width>(node.MaximumY, lane), minimum[1]);
+			auto overlapZ = Simd::LessThanOrEqual(LoadLanes<Width>(node.MinimumZ, lane), maximum[2]) & Simd::GreaterThanOrEqual(LoadLanes<Width>(node.MaximumZ, lane), minimum[2]);
+
+			mask |= static_cast<unsigned>(Simd::MoveMask(overlapX & overlapY & overlapZ)) << lane;
+		}
+
+		return mask & ((1u << Width) - 1);
+	}
+
+	template<int Width>
+	auto RaycastWide(const std::vector<Bvh::WideNode<Width>>& nodes, const std::vector<int>& indices, Point3 origin, Vector3 inverse, float& distance, bool (*intersect)(void*, int, float&), void* context) -> int
+	{
+		Simd::Wide wideOrigin[3] = { Simd::Wide::Broadcast(origin.X), Simd::Wide::Broadcast(origin.Y), Simd::Wide::Broadcast(origin.Z) };
+		Simd::Wide wideInverse[3] = { Simd::Wide::Broadcast(inverse.X), Simd::Wide::Broadcast(inverse.Y), Simd::Wide::Broadcast(inverse.Z) };
+
+		StackEntry stack[_stackSize];
+		auto size = 0;
+		auto hit = -1;
+
+		stack[size++] = { 0, 0, 0.0f };
+
+		while (size > 0)
+		{
+			auto entry = stack[--size];
+
+			if (entry.Near > distance)
+				continue;
+
+			if (entry.Count > 0)
+			{
+				for (auto index = entry.Child; index < entry.Child + entry.Count; index++)
+				{
+					if (intersect(context, indices[index], distance))
+						hit = indices[index];
+				}
+
+				continue;
+			}
+
+			auto& node = nodes[entry.Child];
+			float near[Width];
+			auto mask = IntersectChildren(node, wideOrigin, wideInverse, distance, near);
+
+			// Children are pushed farthest first so the nearest is visited next.
+
+			auto first = size;
+
+			for (; mask; mask &= mask - 1)
+			{
+				auto slot = Simd::CountTrailingZeros(mask);
+
+				if (node.Count[slot] < 0)
+					continue;
+
+				auto position = size++;
+				StackEntry child = { node.Child[slot], node.Count[slot], near[slot] };
+
+				for (; position > first && stack[position - 1].Near < child.Near; position--)
+					stack[position] = stack[position - 1];
+
+				stack[position] = child;
+			}
+
+			assert(size < _stackSize - Width);
+		}
+
+		return hit;
+	}
+
+	void Append(const int* indices, int count, int* primitives, int capacity, int& total)
+	{
+		auto copied = std::min(count, capacity - total);
+
+		if (copied > 0)
+			std::copy(indices, indices + copied, primitives + total);
+
+		total += count;
+	}
+
+	template<int Width>
+	void QueryWide(const std::vector<Bvh::WideNode<Width>>& nodes, const std::vector<int>& indices, const Aabb3& bounds, int* primitives, int capacity, int& total)
+	{
+		Simd::Wide minimum[3] = { Simd::Wide::Broadcast(bounds.Minimum.X), Simd::Wide::Broadcast(bounds.Minimum.Y), Simd::Wide::Broadcast(bounds.Minimum.Z) };
+		Simd::Wide maximum[3] = { Simd::Wide::Broadcast(bounds.Maximum.X), Simd::Wide::Broadcast(bounds.Maximum.Y), Simd::Wide::Broadcast(bounds.Maximum.Z) };
+
+		int stack[_stackSize];
+		auto size = 0;
+
+		stack[size++] = 0;
+
+		while (size > 0)
+		{
+			auto& node = nodes[stack[--size]];
+
+			for (auto mask = OverlapChildren(node, minimum, maximum); mask; mask &= mask - 1)
+			{
+				auto slot = Simd::CountTrailingZeros(mask);
+
+				if (node.Count[slot] > 0)
+					Append(indices.data() + node.Child[slot], node.Count[slot], primitives, capacity, total);
+				else if (node.Count[slot] == 0)
+					stack[size++] = node.Child[slot];
+			}
+
+			assert(size < _stackSize - Width);
+		}
+	}
+
+	// Children are always stored after their parent, so a tree that passes this can not loop or read past its storage,
+	// and its depth is limited so traversal can not overflow its stack.
+	auto IsValid(const std::vector<Bvh::Node>& nodes, const std::vector<int>& indices) -> bool
+	{
+		auto nodeCount = static_cast<int>(nodes.size());
+		auto indexCount = static_cast<std::int64_t>(indices.size());
+		std::vector<int> depths(nodeCount, 0);
+
+		for (auto index = 0; index < nodeCount; index++)
+		{
+			auto& node = nodes[index];
+
+			if (node.Count > 0)
+			{
+				if (node.Offset < 0 || node.Offset + static_cast<std::int64_t>(node.Count) > indexCount)
+					return false;
+			}
+			else if (node.Count < 0 || index + 1 >= nodeCount || node.Offset <= index + 1 || node.Offset >= nodeCount || depths[index] >= 2 * _maximumDepth)
+			{
+				return false;
+			}
+			else
+			{
+				depths[index + 1] = std::max(depths[index + 1], depths[index] + 1);
+				depths[node.Offset] = std::max(depths[node.Offset], depths[index] + 1);
+			}
+		}
+
+		return std::all_of(indices.begin(), indices.end(), [](int primitive) { return primitive >= 0; });
+	}
+}
+
+struct Bvh::Data
+{
+	int Width = 2;
+	std::vector<Node> Nodes;
+	std::vector<int> Indices;
+	std::vector<WideNode<4>> Nodes4;
+	std::vector<WideNode<8>> Nodes8;
+
+	int LeafSize = DefaultLeafSize;
+	std::vector<BuildPrimitive> Primitives;
+	std::vector<BuildNode> TopNodes;
+	std::vector<BuildTaskData> Tasks;
+
+	auto Split(BuildNode& node, BuildNode& left, BuildNode& right) -> bool;
+	void Emit(const std::vector<BuildNode>& nodes, int root);
+};
+
+Bvh::Bvh() :
+	_data(std::make_unique<Data>())
+{
+}
+
+Bvh::Bvh(const Bvh& copy) :
+	_data(std::make_unique<Data>(*copy._data))
+{
+}
+
+Bvh::Bvh(Bvh&& move) noexcept = default;
+Bvh::~Bvh() = default;
+
+auto Bvh::operator=(const Bvh& copy) -> Bvh&
+{
+	if (!_data)
+		_data = std::make_unique<Data>(*copy._data);
+	else if (this != &copy)
+		*_data = *copy._data;
+
+	return *this;
+}
+
+auto Bvh::operator=(Bvh&& move) noexcept -> Bvh&
+{
+	std::swap(_data, move._data);
+	return *this;
+}
+
+auto Bvh::GetNodeCount() const -> int
+{
+	return static_cast<int>(_data->Nodes.size());
+}
+
+auto Bvh::GetNodes() const -> const Node*
+{
+	return _data->Nodes.data();
+}
+
+auto Bvh::GetIndexCount() const -> int
+{
+	return static_cast<int>(_data->Indices.size());
+}
+
+auto Bvh::GetIndices() const -> const int*
+{
+	return _data->Indices.data();
+}
+
+auto Bvh::GetWidth() const -> int
+{
+	return _data->Width;
+}
+
+auto Bvh::GetBounds() const -> Aabb3
+{
+	return _data->Nodes.empty() ? Aabb3::CreateEmpty() : _data->Nodes.front().Bounds;
+}
+
+void Bvh::Build(const Aabb3* bounds, int count, int leafSize)
+{
+	BeginBuild(bounds, count, leafSize, 1);
+
+	for (auto task = 0; task < GetTaskCount(); task++)
+		BuildTask(task);
+
+	EndBuild();
+}
+
+void Bvh::BeginBuild(const Aabb3* bounds, int count, int leafSize, int taskCount)
+{
+	assert(leafSize > 0);
+	assert(taskCount > 0);
+
+	_data->LeafSize = leafSize;
+	_data->Width = 2;
+	_data->Nodes.clear();
+	_data->Nodes4.clear();
+	_data->Nodes8.clear();
+	_data->TopNodes.clear();
+	_data->Tasks.clear();
+
+	_data->Indices.clear();
+	_data->Primitives.resize(count);
+
+	for (auto index = 0; index < count; index++)
+		_data->Primitives[index] = { bounds[index], index };
+
+	if (count == 0)
+		return;
+
+	// The top of the tree is split here until every remaining subtree is small enough to be one task.
+
+	auto granularity = std::max(count / taskCount, leafSize);
+	_data->TopNodes.push_back({ MergeBounds(bounds, count), 0, count, 0, -1, -1, -1 });
+
+	for (auto index = 0; index < static_cast<int>(_data->TopNodes.size()); index++)
+	{
+		auto node = _data->TopNodes[index];
+
+		if (node.Count <= granularity)
+		{
+			_data->TopNodes[index].Task = static_cast<int>(_data->Tasks.size());
+			_data->Tasks.push_back({ index, {} });
+			continue;
+		}
+
+		BuildNode left, right;
+
+		if (_data->Split(node, left, right))
+		{
+			node.Left = static_cast<int>(_data->TopNodes.size());
+			_data->TopNodes.push_back(left);
+			node.Right = static_cast<int>(_data->TopNodes.size());
+			_data->TopNodes.push_back(right);
+			_data->TopNodes[index] = node;
+		}
+	}
+}
+
+auto Bvh::GetTaskCount() const -> int
+{
+	return static_cast<int>(_data->Tasks.size());
+}
+
+void Bvh::BuildTask(int task)
+{
+	auto& nodes = _data->Tasks[task].Nodes;
+	auto root = _data->TopNodes[_data->Tasks[task].Root];
+
+	root.Task = -1;
+	nodes.clear();
+	nodes.push_back(root);
+
+	for (auto index = 0; index < static_cast<int>(nodes.size()); index++)
+	{
+		auto node = nodes[index];
+		BuildNode left, right;
+
+		if (_data->Split(node, left, right))
+		{
+			node.Left = static_cast<int>(nodes.size());
+			nodes.push_back(left);
+			node.Right = static_cast<int>(nodes.size());
+			nodes.push_back(right);
+			nodes[index] = node;
+		}
+	}
+}
+
+void Bvh::EndBuild()
+{
+	if (!_data->TopNodes.empty())
+		_data->Emit(_data->TopNodes, 0);
+
+	_data->Indices.resize(_data->Primitives.size());
+
+	for (auto index = 0; index < static_cast<int>(_data->Primitives.size()); index++)
+		_data->Indices[index] = _data->Primitives[index].Index;
+
+	_data->Primitives.clear();
+	_data->TopNodes.clear();
+	_data->Tasks.clear();
+}
+
+void Bvh::Collapse(int width)
+{
+	assert(width == 4 || width == 8);
+
+	_data->Width = width;
+	_data->Nodes4.clear();
+	_data->Nodes8.clear();
+
+	if (_data->Nodes.empty())
+		return;
+
+	if (width == 4)
+		CollapseNode(_data->Nodes, 0, _data->Nodes4);
+	else
+		CollapseNode(_data->Nodes, 0, _data->Nodes8);
+}
+
+auto Bvh::Query(const Aabb3& bounds, int* primitives, int capacity) const -> int
+{
+	auto& nodes = _data->Nodes;
+	auto& indices = _data->Indices;
+	auto total = 0;
+
+	if (nodes.empty())
+		return total;
+
+	if (_data->Width == 4)
+	{
+		QueryWide(_data->Nodes4, indices, bounds, primitives, capacity, total);
+		return total;
+	}
+
+	if (_data->Width == 8)
+	{
+		QueryWide(_data->Nodes8, indices, bounds, primitives, capacity, total);
+		return total;
+	}
+
+	int stack[_stackSize];
+	auto size = 0;
+
+	stack[size++] = 0;
+
+	while (size > 0)
+	{
+		auto index = stack[--size];
+		auto& node = nodes[index];
+
+		if (!node.Bounds.Overlaps(bounds))
+			continue;
+
+		if (node.Count > 0)
+		{
+			Append(indices.data() + node.Offset, node.Count, primitives, capacity, total);
+		}
+		else
+		{
+			stack[size++] = node.Offset;
+			stack[size++] = index + 1;
+		}
+
+		assert(size < _stackSize - 2);
+	}
+
+	return total;
+}
+
+void Bvh::ToBuffer(BufferWriter& writer) const
+{
+	writer.Write(_data->Width);
+	writer.Write(static_cast<int>(_data->Nodes.size()));
+	writer.Write(static_cast<int>(_data->Indices.size()));
+
+	for (auto& node : _data->Nodes)
+	{
+		node.Bounds.ToBuffer(writer);
+		writer.Write(node.Offset);
+		writer.Write(node.Count);
+	}
+
+	for (auto index : _data->Indices)
+		writer.Write(index);
+}
+
+void Bvh::FromBuffer(BufferReader& reader)
+{
+	// Wide nodes are not stored since collapsing is a single linear pass over the binary nodes. Both counts are read
+	// first so a node count that no tree over the indices could have is rejected before anything is read, and storage
+	// grows as entries are read rather than being sized from the counts up front.
+
+	auto width = 0;
+	auto nodeCount = 0;
+	auto indexCount = 0;
+
+	_data->Width = 2;
+	_data->Nodes.clear();
+	_data->Nodes4.clear();
+	_data->Nodes8.clear();
+	_data->Indices.clear();
+
+	reader.Read(width);
+	reader.Read(nodeCount);
+	reader.Read(indexCount);
+
+	if (width != 2 && width != 4 && width != 8)
+		return;
+
+	if (nodeCount < 0 || indexCount < 0 || nodeCount > std::max(2 * static_cast<std::int64_t>(indexCount) - 1, std::int64_t(0)))
+		return;
+
+	_data->Nodes.reserve(std::min(nodeCount, _readChunkSize));
+	_data->Indices.reserve(std::min(indexCount, _readChunkSize));
+
+	for (auto index = 0; index < nodeCount; index++)
+	{
+		Node node;
+		node.Bounds.FromBuffer(reader);
+		reader.Read(node.Offset);
+		reader.Read(node.Count);
+		_data->Nodes.push_back(node);
+	}
+
+	for (auto index = 0; index < indexCount; index++)
+	{
+		auto primitive = 0;
+		reader.Read(primitive);
+		_data->Indices.push_back(primitive);
+	}
+
+	if (!IsValid(_data->Nodes, _data->Indices))
+	{
+		_data->Nodes.clear();
+		_data->Indices.clear();
+		return;
+	}
+
+	if (width == 4 || width == 8)
+		Collapse(width);
+}
+
+auto Bvh::Data::Split(BuildNode& node, BuildNode& left, BuildNode& right) -> bool
+{
+	if (node.Count <= LeafSize)
+		return false;
+
+	auto begin = Primitives.begin() + node.Start;
+	auto end = begin + node.Count;
+	auto centroids = Aabb3::CreateEmpty();
+
+	for (auto index = begin; index != end; index++)
+		Grow(centroids, GetCentroid(index->Bounds));
+
+	float low[3], scale[3];
+	Bin bins[3][_binCount];
+
+	for (auto axis = 0; axis < 3; axis++)
+	{
+		auto extent = Component(centroids.Maximum, axis) - Component(centroids.Minimum, axis);
+
+		low[axis] = Component(centroids.Minimum, axis);
+		scale[axis] = extent > 0.0f && node.Depth < _maximumDepth ? _binCount / extent : 0.0f;
+
+		for (auto& bin : bins[axis])
+			bin = { Aabb3::CreateEmpty(), 0 };
+	}
+
+	if (node.Depth < _maximumDepth)
+	{
+		for (auto index = begin; index != end; index++)
+		{
+			auto& bounds = index->Bounds;
+			auto centroid = GetCentroid(bounds);
+
+			for (auto axis = 0; axis < 3; axis++)
+			{
+				auto& bin = bins[axis][GetBin(Component(centroid, axis), low[axis], scale[axis])];
+				Grow(bin.Bounds, bounds);
+				bin.Count++;
+			}
+		}
+	}
+
+	auto bestAxis = -1;
+	auto bestSplit = 0;
+	auto bestCost = std::numeric_limits<float>::max();
+	auto bestLeft = Aabb3::CreateEmpty();
+	auto bestRight = Aabb3::CreateEmpty();
+
+	for (auto axis = 0; axis < 3; axis++)
+	{
+		if (scale[axis] == 0.0f)
+			continue;
+
+		Aabb3 rightBounds[_binCount];
+		float rightCosts[_binCount];
+		auto bounds = Aabb3::CreateEmpty();
+		auto count = 0;
+
+		for (auto bin = _binCount - 1; bin > 0; bin--)
+		{
+			Grow(bounds, bins[axis][bin].Bounds);
+			count += bins[axis][bin].Count;
+			rightBounds[bin] = bounds;
+			rightCosts[bin] = count > 0 ? GetSurfaceArea(bounds) * count : 0.0f;
+		}
+
+		bounds = Aabb3::CreateEmpty();
+		count = 0;
+
+		for (auto bin = 0; bin < _binCount - 1; bin++)
+		{
+			Grow(bounds, bins[axis][bin].Bounds);
+			count += bins[axis][bin].Count;
+
+			if (count == 0 || count == node.Count)
+				continue;
+
+			auto cost = GetSurfaceArea(bounds) * count + rightCosts[bin + 1];
+
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				bestAxis = axis;
+				bestSplit = bin;
+				bestLeft = bounds;
+				bestRight = rightBounds[bin + 1];
+			}
+		}
+	}
+
+	auto middle = begin;
+
+	if (bestAxis >= 0)
+	{
+		middle = std::partition(begin, end, [&](const BuildPrimitive& primitive)
+		{
+			return GetBin(Component(GetCentroid(primitive.Bounds), bestAxis), low[bestAxis], scale[bestAxis]) <= bestSplit;
+		});
+	}
+	else
+	{
+		// Without a usable SAH split, either because every centroid is the same or the tree is too deep, the range is
+		// split in half along its longest axis so the depth stays logarithmic.
+
+		auto size = centroids.Maximum - centroids.Minimum;
+		auto axis = size.X >= size.Y && size.X >= size.Z ? 0 : (size.Y >= size.Z ? 1 : 2);
+
+		middle = begin + node.Count / 2;
+		std::nth_element(begin, middle, end, [&](const BuildPrimitive& first, const BuildPrimitive& second) { return Component(GetCentroid(first.Bounds), axis) < Component(GetCentroid(second.Bounds), axis); });
+
+		for (auto index = begin; index != middle; index++)
+			Grow(bestLeft, index->Bounds);
+
+		for (auto index = middle; index != end; index++)
+			Grow(bestRight, index->Bounds);
+	}
+
+	auto leftCount = static_cast<int>(middle - begin);
+
+	left = { bestLeft, node.Start, leftCount, node.Depth + 1, -1, -1, -1 };
+	right = { bestRight, node.Start + leftCount, node.Count - leftCount, node.Depth + 1, -1, -1, -1 };
+	return true;
+}
+
+void Bvh::Data::Emit(const std::vector<BuildNode>& nodes, int root)
+{
+	struct Entry
+	{
+		const std::vector<BuildNode>* Nodes;
+		int Index;
+		int Parent;
+	};
+
+	std::vector<Entry> stack = { { &nodes, root, -1 } };
+
+	while (!stack.empty())
+	{
+		auto entry = stack.back();
+		stack.pop_back();
+
+		if ((*entry.Nodes)[entry.Index].Task >= 0)
+		{
+			entry.Nodes = &Tasks[(*entry.Nodes)[entry.Index].Task].Nodes;
+			entry.Index = 0;
+		}
+
+		auto& node = (*entry.Nodes)[entry.Index];
+		auto position = static_cast<int>(Nodes.size());
+
+		if (entry.Parent >= 0)
+			Nodes[entry.Parent].Offset = position;
+
+		if (node.Left < 0)
+		{
+			Nodes.push_back({ node.Bounds, node.Start, node.Count });
+		}
+		else
+		{
+			Nodes.push_back({ node.Bounds, 0, 0 });
+			stack.push_back({ entry.Nodes, node.Right, position });
+			stack.push_back({ entry.Nodes, node.Left, -1 });
+		}
+	}
+}
+
+auto Bvh::RaycastNodes(Point3 origin, Vector3 direction, float& distance, IntersectFunction intersect, void* context) const -> int
+{
+	auto& nodes = _data->Nodes;
+	auto& indices = _data->Indices;
+
+	if (nodes.empty())
+		return -1;
+
+	auto inverse = Vector3{ 1.0f / direction.X, 1.0f / direction.Y, 1.0f / direction.Z };
+
+	if (_data->Width == 4)
+		return RaycastWide(_data->Nodes4, indices, origin, inverse, distance, intersect, context);
+
+	if (_data->Width == 8)
+		return RaycastWide(_data->Nodes8, indices, origin, inverse, distance, intersect, context);
+
+	StackEntry stack[_stackSize];
+	auto size = 0;
+	auto hit = -1;
+	auto near = 0.0f;
+
+	if (!IntersectBox(nodes.front().Bounds, origin, inverse, distance, near))
+		return -1;
+
+	stack[size++] = { 0, 0, near };
+
+	while (size > 0)
+	{
+		auto entry = stack[--size];
+
+		if (entry.Near > distance)
+			continue;
+
+		auto& node = nodes[entry.Child];
+
+		if (node.Count > 0)
+		{
+			for (auto index = node.Offset; index < node.Offset + node.Count; index++)
+			{
+				if (intersect(context, indices[index], distance))
+					hit = indices[index];
+			}
+
+			continue;
+		}
+
+		auto leftNear = 0.0f, rightNear = 0.0f;
+		auto leftHit = IntersectBox(nodes[entry.Child + 1].Bounds, origin, inverse, distance, leftNear);
+		auto rightHit = IntersectBox(nodes[node.Offset].Bounds, origin, inverse, distance, rightNear);
+
+		if (leftHit && rightHit)
+		{
+			auto leftFirst = leftNear <= rightNear;
+			stack[size++] = leftFirst ? StackEntry{ node.Offset, 0, rightNear } : StackEntry{ entry.Child + 1, 0, leftNear };
+			stack[size++] = leftFirst ? StackEntry{ entry.Child + 1, 0, leftNear } : StackEntry{ node.Offset, 0, rightNear };
+		}
+		else if (leftHit)
+		{
+			stack[size++] = { entry.Child + 1, 0, leftNear };
+		}
+		else if (rightHit)
+		{
+			stack[size++] = { node.Offset, 0, rightNear };
+		}
+
+		assert(size < _stackSize - 2);
+	}
+
+	return hit;
+}
@@ -0,0 +1,192 @@
+#include "Pargon/Math/DualQuaternion.h"
+#include "Pargon/Serialization/BufferReader.h"
+#include "Pargon/Serialization/BufferWriter.h"
+#include "Pargon/Serialization/StringReader.h"
+#include "Pargon/Serialization/StringWriter.h"
+
+#include <cassert>
+#include <cmath>
+
+using namespace Pargon;
+
+namespace
+{
+	// Same product as Quaternion::operator* without the normalization, so left is applied before right.
+	auto Multiply(Quaternion left, Quaternion right) -> Quaternion
+	{
+		return
+		{
+			(left.W * right.X + right.W * left.X) - (left.Y * right.Z - left.Z * right.Y),
+			(left.W * right.Y + right.W * left.Y) - (left.Z * right.X - left.X * right.Z),
+			(left.W * right.Z + right.W * left.Z) - (left.X * right.Y - left.Y * right.X),
+			left.W * right.W - left.X * right.X - left.Y * right.Y - left.Z * right.Z
+		};
+	}
+
+	auto Conjugate(Quaternion quaternion) -> Quaternion
+	{
+		return { -quaternion.X, -quaternion.Y, -quaternion.Z, quaternion.W };
+	}
+
+	auto Dot(Quaternion left, Quaternion right) -> float
+	{
+		return left.X * right.X + left.Y * right.Y + left.Z * right.Z + left.W * right.W;
+	}
+
+	auto MultiplyAdd(Quaternion quaternion, float scale, Quaternion addend) -> Quaternion
+	{
+		return { quaternion.X * scale + addend.X, quaternion.Y * scale + addend.Y, quaternion.Z * scale + addend.Z, quaternion.W * scale + addend.W };
+	}
+
+	auto Cross(Vector3 left, Vector3 right) -> Vector3
+	{
+		return { left.Y * right.Z - left.Z * right.Y, left.Z * right.X - left.X * right.Z, left.X * right.Y - left.Y * right.X };
+	}
+
+	auto Rotate(Quaternion rotation, Vector3 vector) -> Vector3
+	{
+		auto axis = Vector3{ rotation.X, rotation.Y, rotation.Z };
+		auto first = Cross(axis, vector);
+		auto second = Cross(axis, first);
+
+		return vector + (first * rotation.W + second) * 2.0f;
+	}
+}
+
+auto DualQuaternion::CreateTranslation(Vector3 translation) -> DualQuaternion
+{
+	return { Quaternion::CreateIdentity(), { translation.X * 0.5f, translation.Y * 0.5f, translation.Z * 0.5f, 0.0f } };
+}
+
+auto DualQuaternion::CreateTransform(Vector3 translation, Quaternion rotation) -> DualQuaternion
+{
+	auto dual = Multiply(rotation, { translation.X, translation.Y, translation.Z, 0.0f });
+	return { rotation, { dual.X * 0.5f, dual.Y * 0.5f, dual.Z * 0.5f, dual.W * 0.5f } };
+}
+
+auto DualQuaternion::CreateFromTransform(const Matrix4x4::Transform& transform) -> DualQuaternion
+{
+	return CreateTransform(transform.Translation, transform.Rotation);
+}
+
+auto DualQuaternion::CreateFromMatrix(const Matrix4x4& matrix) -> DualQuaternion
+{
+	return CreateFromTransform(matrix.GetTransform());
+}
+
+auto DualQuaternion::operator*=(const DualQuaternion& right) -> DualQuaternion&
+{
+	*this = *this * right;
+	return *this;
+}
+
+auto DualQuaternion::operator*(const DualQuaternion& right) const -> DualQuaternion
+{
+	auto first = Multiply(Dual, right.Real);
+	auto second = Multiply(Real, right.Dual);
+
+	return { Multiply(Real, right.Real), { first.X + second.X, first.Y + second.Y, first.Z + second.Z, first.W + second.W } };
+}
+
+auto DualQuaternion::GetRotation() const -> Quaternion
+{
+	return Real;
+}
+
+auto DualQuaternion::GetTranslation() const -> Vector3
+{
+	auto translation = Multiply(Conjugate(Real), Dual);
+	return { translation.X * 2.0f, translation.Y * 2.0f, translation.Z * 2.0f };
+}
+
+auto DualQuaternion::GetTransform() const -> Matrix4x4::Transform
+{
+	return { GetTranslation(), { 1.0f, 1.0f, 1.0f }, Real };
+}
+
+auto DualQuaternion::Get4x4() const -> Matrix4x4
+{
+	return Matrix4x4::CreateTransform(GetTranslation(), { 1.0f, 1.0f, 1.0f }, Real, { 0.0f, 0.0f, 0.0f });
+}
+
+auto DualQuaternion::TransformPoint(Point3 point) const -> Point3
+{
+	auto result = Rotate(Real, { point.X, point.Y, point.Z }) + GetTranslation();
+	return { result.X, result.Y, result.Z };
+}
+
+auto DualQuaternion::TransformVector(Vector3 vector) const -> Vector3
+{
+	return Rotate(Real, vector);
+}
+
+void DualQuaternion::Normalize()
+{
+	auto length = std::sqrt(Dot(Real, Real));
+	assert(length > 0.0f);
+
+	auto scale = 1.0f / length;
+	Real = MultiplyAdd(Real, scale, { 0.0f, 0.0f, 0.0f, 0.0f });
+	Dual = MultiplyAdd(Dual, scale, { 0.0f, 0.0f, 0.0f, 0.0f });
+	Dual = MultiplyAdd(Real, -Dot(Real, Dual), Dual);
+}
+
+void DualQuaternion::Invert()
+{
+	Real = Conjugate(Real);
+	Dual = Conjugate(Dual);
+}
+
+auto DualQuaternion::Normalized() const -> DualQuaternion
+{
+	auto copy = *this;
+	copy.Normalize();
+	return copy;
+}
+
+auto DualQuaternion::Inverted() const -> DualQuaternion
+{
+	auto copy = *this;
+	copy.Invert();
+	return copy;
+}
+
+void DualQuaternion::ToBuffer(BufferWriter& writer) const
+{
+	Real.ToBuffer(writer);
+	Dual.ToBuffer(writer);
+}
+
+void DualQuaternion::FromBuffer(BufferReader& reader)
+{
+	Real.FromBuffer(reader);
+	Dual.FromBuffer(reader);
+}
+
+void DualQuaternion::ToString(StringWriter& writer, StringView format) const
+{
+	writer.Format("{} {} {} {} {} {} {} {}", Real.X, Real.Y, Real.Z, Real.W, Dual.X, Dual.Y, Dual.Z, Dual.W);
+}
+
+void DualQuaternion::FromString(StringReader& reader, StringView format)
+{
+	if (!reader.Parse("{} {} {} {} {} {} {} {}", Real.X, Real.Y, Real.Z, Real.W, Dual.X, Dual.Y, Dual.Z, Dual.W))
+		reader.ReportError("the string could not be read as a DualQuaternion (expected eight floating point numbers separated by a space");
+}
+
+void Pargon::BlendDualQuaternions(const DualQuaternion* transforms, const float* weights, int count, DualQuaternion& result)
+{
+	assert(count > 0);
+
+	result = { { 0.0f, 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f, 0.0f } };
+
+	for (auto index = 0; index < count; index++)
+	{
+		auto weight = Dot(transforms[0].Real, transforms[index].Real) < 0.0f ? -weights[index] : weights[index];
+
+		result.Real = MultiplyAdd(transforms[index].Real, weight, result.Real);
+		result.Dual = MultiplyAdd(transforms[index].Dual, weight, result.Dual);
+	}
+
+	result.Normalize();
+}
@@ -0,0 +1,195 @@
+#include "Pargon/Math/Frustum.h"
+#include "Pargon/Math/Matrix.h"
+#include "Pargon/Math/Stream.h"
+#include "Core/Simd.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cml/cml.h>
+
+using namespace Pargon;
+
+namespace
+{
+	struct WidePlanes
+	{
+		Simd::Wide X[Frustum::PlaneCount];
+		Simd::Wide Y[Frustum::PlaneCount];
+		Simd::Wide Z[Frustum::PlaneCount];
+		Simd::Wide Distance[Frustum::PlaneCount];
+	};
+
+	auto LoadPlanes(const Frustum& frustum, bool absolute) -> WidePlanes
+	{
+		WidePlanes planes;
+
+		for (auto index = 0; index < Frustum::PlaneCount; index++)
+		{
+			auto& plane = frustum.Planes.Item(index);
+
+			planes.X[index] = Simd::Wide::Broadcast(absolute ? std::abs(plane.Normal.X) : plane.Normal.X);
+			planes.Y[index] = Simd::Wide::Broadcast(absolute ? std::abs(plane.Normal.Y) : plane.Normal.Y);
+			planes.Z[index] = Simd::Wide::Broadcast(absolute ? std::abs(plane.Normal.Z) : plane.Normal.Z);
+			planes.Distance[index] = Simd::Wide::Broadcast(plane.Distance);
+		}
+
+		return planes;
+	}
+
+	auto Distance(const WidePlanes& planes, int index, Simd::Wide x, Simd::Wide y, Simd::Wide z) -> Simd::Wide
+	{
+		return Simd::MultiplyAdd(z, planes.Z[index], Simd::MultiplyAdd(y, planes.Y[index], Simd::MultiplyAdd(x, planes.X[index], planes.Distance[index])));
+	}
+
+	auto Radius(const WidePlanes& planes, int index, Simd::Wide x, Simd::Wide y, Simd::Wide z) -> Simd::Wide
+	{
+		return Simd::MultiplyAdd(z, planes.Z[index], Simd::MultiplyAdd(y, planes.Y[index], x * planes.X[index]));
+	}
+
+	auto BlockMask(int index, int count, Simd::Wide visible) -> std::uint32_t
+	{
+		auto mask = static_cast<std::uint32_t>(Simd::MoveMask(visible));
+		auto remaining = count - index;
+
+		return remaining < Simd::Wide::Width ? mask & ((1u << remaining) - 1) : mask;
+	}
+
+	template<typename Test>
+	void CullToBits(int count, Test test, std::uint32_t* visibility)
+	{
+		std::fill(visibility, visibility + (count + 31) / 32, 0u);
+
+		for (auto index = 0; index < count; index += Simd::Wide::Width)
+			visibility[index / 32] |= BlockMask(index, count, test(index)) << (index % 32);
+	}
+
+	template<typename Test>
+	auto CullToIndices(int count, Test test, int* visible) -> int
+	{
+		auto visibleCount = 0;
+
+		for (auto index = 0; index < count; index += Simd::Wide::Width)
+		{
+			auto mask = BlockMask(index, count, test(index));
+			auto lanes = std::min(count - index, Simd::Wide::Width);
+
+			for (auto lane = 0; lane < lanes; lane++)
+			{
+				visible[visibleCount] = index + lane;
+				visibleCount += (mask >> lane) & 1;
+			}
+		}
+
+		return visibleCount;
+	}
+
+	auto TestSpheres(const WidePlanes& planes, const Point3Stream& centers, const FloatStream& radii, int index) -> Simd::Wide
+	{
+		auto x = Simd::Wide::Load(centers.GetX() + index);
+		auto y = Simd::Wide::Load(centers.GetY() + index);
+		auto z = Simd::Wide::Load(centers.GetZ() + index);
+		auto radius = Simd::Wide::Load(radii.Data() + index);
+
+		auto nearest = Distance(planes, 0, x, y, z);
+
+		for (auto plane = 1; plane < Frustum::PlaneCount; plane++)
+			nearest = Simd::Minimum(nearest, Distance(planes, plane, x, y, z));
+
+		return Simd::GreaterThanOrEqual(nearest + radius, Simd::Wide::Broadcast(0.0f));
+	}
+
+	auto TestBoxes(const WidePlanes& planes, const WidePlanes& absolutePlanes, const Point3Stream& centers, const Vector3Stream& extents, int index) -> Simd::Wide
+	{
+		auto x = Simd::Wide::Load(centers.GetX() + index);
+		auto y = Simd::Wide::Load(centers.GetY() + index);
+		auto z = Simd::Wide::Load(centers.GetZ() + index);
+		auto extentX = Simd::Wide::Load(extents.GetX() + index);
+		auto extentY = Simd::Wide::Load(extents.GetY() + index);
+		auto extentZ = Simd::Wide::Load(extents.GetZ() + index);
+
+		auto nearest = Distance(planes, 0, x, y, z) + Radius(absolutePlanes, 0, extentX, extentY, extentZ);
+
+		for (auto plane = 1; plane < Frustum::PlaneCount; plane++)
+			nearest = Simd::Minimum(nearest, Distance(planes, plane, x, y, z) + Radius(absolutePlanes, plane, extentX, extentY, extentZ));
+
+		return Simd::GreaterThanOrEqual(nearest, Simd::Wide::Broadcast(0.0f));
+	}
+}
+
+auto Frustum::CreateFromMatrix(const Matrix4x4& viewProjection) -> Frustum
+{
+	float planes[PlaneCount][4];
+	cml::matrix<float, cml::external<4, 4>, cml::row_basis, cml::row_major> m(const_cast<float*>(viewProjection.Elements.begin()));
+	cml::extract_frustum_planes(m, planes, cml::z_clip_zero);
+
+	Frustum frustum;
+
+	for (auto index = 0; index < PlaneCount; index++)
+		frustum.Planes.Item(index) = { { planes[index][0], planes[index][1], planes[index][2] }, planes[index][3] };
+
+	return frustum;
+}
+
+auto Frustum::Contains(Point3 point) const -> bool
+{
+	return IntersectsSphere(point, 0.0f);
+}
+
+auto Frustum::IntersectsSphere(Point3 center, float radius) const -> bool
+{
+	for (auto& plane : Planes)
+	{
+		if (plane.Normal.X * center.X + plane.Normal.Y * center.Y + plane.Normal.Z * center.Z + plane.Distance < -radius)
+			return false;
+	}
+
+	return true;
+}
+
+auto Frustum::IntersectsBox(Point3 center, Vector3 extents) const -> bool
+{
+	for (auto& plane : Planes)
+	{
+		auto radius = std::abs(plane.Normal.X) * extents.X + std::abs(plane.Normal.Y) * extents.Y + std::abs(plane.Normal.Z) * extents.Z;
+
+		if (plane.Normal.X * center.X + plane.Normal.Y * center.Y + plane.Normal.Z * center.Z + plane.Distance < -radius)
+			return false;
+	}
+
+	return true;
+}
+
+void Frustum::CullSpheres(const Point3Stream& centers, const FloatStream& radii, std::uint32_t* visibility) const
+{
+	assert(centers.Count() == radii.Count());
+
+	auto planes = LoadPlanes(*this, false);
+	CullToBits(centers.Count(), [&](int index) { return TestSpheres(planes, centers, radii, index); }, visibility);
+}
+
+auto Frustum::CullSpheres(const Point3Stream& centers, const FloatStream& radii, int* visible) const -> int
+{
+	assert(centers.Count() == radii.Count());
+
+	auto planes = LoadPlanes(*this, false);
+	return CullToIndices(centers.Count(), [&](int index) { return TestSpheres(planes, centers, radii, index); }, visible);
+}
+
+void Frustum::CullBoxes(const Point3Stream& centers, const Vector3Stream& extents, std::uint32_t* visibility) const
+{
+	assert(centers.Count() == extents.Count());
+
+	auto planes = LoadPlanes(*this, false);
+	auto absolutePlanes = LoadPlanes(*this, true);
+	CullToBits(centers.Count(), [&](int index) { return TestBoxes(planes, absolutePlanes, centers, extents, index); }, visibility);
+}
+
+auto Frustum::CullBoxes(const Point3Stream& centers, const Vector3Stream& extents, int* visible) const -> int
+{
+	assert(centers.Count() == extents.Count());
+
+	auto planes = LoadPlanes(*this, false);
+	auto absolutePlanes = LoadPlanes(*this, true);
+	return CullToIndices(centers.Count(), [&](int index) { return TestBoxes(planes, absolutePlanes, centers, extents, index); }, visible);
+}
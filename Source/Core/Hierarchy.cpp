@@ -0,0 +1,377 @@
+#include "Pargon/Math/Hierarchy.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using namespace Pargon;
+
+namespace
+{
+	constexpr int _skipBlockSize = 64;
+
+	template<typename T> void Permute(std::vector<T>& values, const std::vector<int>& order)
+	{
+		std::vector<T> permuted;
+		permuted.reserve(order.size());
+
+		for (auto index : order)
+			permuted.push_back(values[index]);
+
+		values.swap(permuted);
+	}
+}
+
+struct TransformHierarchy::Data
+{
+	std::vector<int> Slots;
+	std::vector<int> Parents;
+	std::vector<std::uint8_t> Removed;
+	std::vector<int> FreeHandles;
+
+	std::vector<int> Handles;
+	std::vector<int> ParentSlots;
+	std::vector<Vector3> Translations;
+	std::vector<Vector3> Scales;
+	std::vector<Quaternion> Rotations;
+	std::vector<Matrix4x4> Worlds;
+	std::vector<std::uint8_t> Dirty;
+	std::vector<int> Levels;
+
+	auto IsDescendant(int node, int ancestor) const -> bool;
+	auto IsAnyDirty(int start, int end) const -> bool;
+	void Rebuild();
+};
+
+TransformHierarchy::TransformHierarchy(int chunkSize) :
+	_data(std::make_unique<Data>()),
+	_chunkSize(chunkSize)
+{
+	assert(chunkSize > 0);
+}
+
+TransformHierarchy::TransformHierarchy(const TransformHierarchy& copy) :
+	_data(std::make_unique<Data>(*copy._data)),
+	_chunkSize(copy._chunkSize),
+	_structureChanged(copy._structureChanged)
+{
+}
+
+TransformHierarchy::TransformHierarchy(TransformHierarchy&& move) noexcept = default;
+TransformHierarchy::~TransformHierarchy() = default;
+
+auto TransformHierarchy::operator=(const TransformHierarchy& copy) -> TransformHierarchy&
+{
+	if (!_data)
+		_data = std::make_unique<Data>(*copy._data);
+	else if (this != &copy)
+		*_data = *copy._data;
+
+	_chunkSize = copy._chunkSize;
+	_structureChanged = copy._structureChanged;
+	return *this;
+}
+
+auto TransformHierarchy::operator=(TransformHierarchy&& move) noexcept -> TransformHierarchy&
+{
+	std::swap(_data, move._data);
+	std::swap(_chunkSize, move._chunkSize);
+	std::swap(_structureChanged, move._structureChanged);
+	return *this;
+}
+
+auto TransformHierarchy::Count() const -> int
+{
+	return static_cast<int>(_data->Slots.size() - _data->FreeHandles.size());
+}
+
+auto TransformHierarchy::IsValid(int node) const -> bool
+{
+	return node >= 0 && node < static_cast<int>(_data->Slots.size()) && _data->Slots[node] != InvalidNode && !_data->Removed[node];
+}
+
+auto TransformHierarchy::AddNode(int parent) -> int
+{
+	return AddNode(parent, { { 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f }, Quaternion::CreateIdentity() });
+}
+
+auto TransformHierarchy::AddNode(int parent, const Matrix4x4::Transform& local) -> int
+{
+	assert(parent == InvalidNode || IsValid(parent));
+
+	auto node = static_cast<int>(_data->Slots.size());
+
+	if (!_data->FreeHandles.empty())
+	{
+		node = _data->FreeHandles.back();
+		_data->FreeHandles.pop_back();
+	}
+	else
+	{
+		_data->Slots.push_back(InvalidNode);
+		_data->Parents.push_back(InvalidNode);
+		_data->Removed.push_back(0);
+	}
+
+	_data->Slots[node] = static_cast<int>(_data->Handles.size());
+	_data->Parents[node] = parent;
+	_data->Removed[node] = 0;
+
+	_data->Handles.push_back(node);
+	_data->ParentSlots.push_back(InvalidNode);
+	_data->Translations.push_back(local.Translation);
+	_data->Scales.push_back(local.Scale);
+	_data->Rotations.push_back(local.Rotation);
+	_data->Worlds.push_back(Matrix4x4::CreateIdentity());
+	_data->Dirty.push_back(1);
+
+	_structureChanged = true;
+	return node;
+}
+
+void TransformHierarchy::RemoveNode(int node)
+{
+	assert(IsValid(node));
+
+	_data->Removed[node] = 1;
+	_structureChanged = true;
+}
+
+void TransformHierarchy::SetParent(int node, int parent)
+{
+	assert(IsValid(node));
+	assert(parent == InvalidNode || IsValid(parent));
+	assert(!_data->IsDescendant(parent, node));
+
+	_data->Parents[node] = parent;
+	_structureChanged = true;
+
+	MarkDirty(node);
+}
+
+auto TransformHierarchy::GetParent(int node) const -> int
+{
+	assert(IsValid(node));
+	return _data->Parents[node];
+}
+
+auto TransformHierarchy::GetLocalTransform(int node) const -> Matrix4x4::Transform
+{
+	assert(IsValid(node));
+
+	auto slot = _data->Slots[node];
+	return { _data->Translations[slot], _data->Scales[slot], _data->Rotations[slot] };
+}
+
+void TransformHierarchy::SetLocalTransform(int node, const Matrix4x4::Transform& local)
+{
+	MarkDirty(node);
+
+	auto slot = _data->Slots[node];
+	_data->Translations[slot] = local.Translation;
+	_data->Scales[slot] = local.Scale;
+	_data->Rotations[slot] = local.Rotation;
+}
+
+void TransformHierarchy::SetTranslation(int node, Vector3 translation)
+{
+	MarkDirty(node);
+	_data->Translations[_data->Slots[node]] = translation;
+}
+
+void TransformHierarchy::SetScale(int node, Vector3 scale)
+{
+	MarkDirty(node);
+	_data->Scales[_data->Slots[node]] = scale;
+}
+
+void TransformHierarchy::SetRotation(int node, Quaternion rotation)
+{
+	MarkDirty(node);
+	_data->Rotations[_data->Slots[node]] = rotation;
+}
+
+auto TransformHierarchy::GetWorldMatrix(int node) const -> const Matrix4x4&
+{
+	assert(IsValid(node));
+	return _data->Worlds[_data->Slots[node]];
+}
+
+void TransformHierarchy::Update()
+{
+	BeginUpdate();
+
+	for (auto level = 0; level < GetLevelCount(); level++)
+	{
+		for (auto chunk = 0; chunk < GetChunkCount(level); chunk++)
+			UpdateChunk(level, chunk);
+	}
+
+	EndUpdate();
+}
+
+void TransformHierarchy::BeginUpdate()
+{
+	if (_structureChanged)
+	{
+		_data->Rebuild();
+		_structureChanged = false;
+	}
+}
+
+auto TransformHierarchy::GetLevelCount() const -> int
+{
+	return _data->Levels.empty() ? 0 : static_cast<int>(_data->Levels.size()) - 1;
+}
+
+auto TransformHierarchy::GetChunkCount(int level) const -> int
+{
+	assert(level >= 0 && level < GetLevelCount());
+	return (_data->Levels[level + 1] - _data->Levels[level] + _chunkSize - 1) / _chunkSize;
+}
+
+void TransformHierarchy::UpdateChunk(int level, int chunk)
+{
+	assert(!_structureChanged);
+	assert(chunk >= 0 && chunk < GetChunkCount(level));
+
+	auto& data = *_data;
+	auto start = data.Levels[level] + chunk * _chunkSize;
+	auto end = std::min(start + _chunkSize, data.Levels[level + 1]);
+
+	for (auto block = start; block < end; block += _skipBlockSize)
+	{
+		auto blockEnd = std::min(block + _skipBlockSize, end);
+
+		// Breadth first order keeps parent slots ascending within a level so the parents of a block are a range too.
+		if (!data.IsAnyDirty(block, blockEnd) && (level == 0 || !data.IsAnyDirty(data.ParentSlots[block], data.ParentSlots[blockEnd - 1] + 1)))
+			continue;
+
+		for (auto slot = block; slot < blockEnd; slot++)
+		{
+			auto parent = data.ParentSlots[slot];
+
+			if (parent != InvalidNode)
+				data.Dirty[slot] |= data.Dirty[parent];
+
+			if (!data.Dirty[slot])
+				continue;
+
+			auto local = Matrix4x4::CreateTransform(data.Translations[slot], data.Scales[slot], data.Rotations[slot], { 0.0f, 0.0f, 0.0f });
+			data.Worlds[slot] = parent != InvalidNode ? local * data.Worlds[parent] : local;
+		}
+	}
+}
+
+void TransformHierarchy::EndUpdate()
+{
+	std::fill(_data->Dirty.begin(), _data->Dirty.end(), static_cast<std::uint8_t>(0));
+}
+
+void TransformHierarchy::MarkDirty(int node)
+{
+	assert(IsValid(node));
+	_data->Dirty[_data->Slots[node]] = 1;
+}
+
+auto TransformHierarchy::Data::IsDescendant(int node, int ancestor) const -> bool
+{
+	for (; node != InvalidNode; node = Parents[node])
+	{
+		if (node == ancestor)
+			return true;
+	}
+
+	return false;
+}
+
+auto TransformHierarchy::Data::IsAnyDirty(int start, int end) const -> bool
+{
+	return std::memchr(Dirty.data() + start, 1, end - start) != nullptr;
+}
+
+void TransformHierarchy::Data::Rebuild()
+{
+	auto handleCount = static_cast<int>(Slots.size());
+
+	std::vector<int> childStarts(handleCount + 1, 0);
+	std::vector<int> children(handleCount);
+	std::vector<int> order;
+	order.reserve(Handles.size());
+
+	for (auto node = 0; node < handleCount; node++)
+	{
+		if (Slots[node] != InvalidNode && Parents[node] != InvalidNode)
+			childStarts[Parents[node] + 1]++;
+	}
+
+	for (auto node = 0; node < handleCount; node++)
+		childStarts[node + 1] += childStarts[node];
+
+	auto childEnds = std::vector<int>(childStarts.begin(), childStarts.end() - 1);
+
+	for (auto slot = 0; slot < static_cast<int>(Handles.size()); slot++)
+	{
+		auto node = Handles[slot];
+
+		if (Parents[node] == InvalidNode)
+		{
+			if (!Removed[node])
+				order.push_back(node);
+		}
+		else
+		{
+			children[childEnds[Parents[node]]++] = node;
+		}
+	}
+
+	Levels.clear();
+	Levels.push_back(0);
+
+	for (auto index = 0; index < static_cast<int>(order.size()); index++)
+	{
+		if (index == Levels.back())
+			Levels.push_back(static_cast<int>(order.size()));
+
+		for (auto child = childStarts[order[index]]; child < childEnds[order[index]]; child++)
+		{
+			if (!Removed[children[child]])
+				order.push_back(children[child]);
+		}
+	}
+
+	std::vector<int> slots(handleCount, InvalidNode);
+	std::vector<int> previousSlots;
+	previousSlots.reserve(order.size());
+
+	for (auto slot = 0; slot < static_cast<int>(order.size()); slot++)
+	{
+		slots[order[slot]] = slot;
+		previousSlots.push_back(Slots[order[slot]]);
+	}
+
+	for (auto node = 0; node < handleCount; node++)
+	{
+		if (Slots[node] != InvalidNode && slots[node] == InvalidNode)
+			FreeHandles.push_back(node);
+	}
+
+	Slots.swap(slots);
+
+	Permute(Translations, previousSlots);
+	Permute(Scales, previousSlots);
+	Permute(Rotations, previousSlots);
+	Permute(Worlds, previousSlots);
+	Permute(Dirty, previousSlots);
+
+	Handles = order;
+	ParentSlots.resize(order.size());
+
+	for (auto slot = 0; slot < static_cast<int>(order.size()); slot++)
+	{
+		auto parent = Parents[order[slot]];
+		ParentSlots[slot] = parent == InvalidNode ? InvalidNode : Slots[parent];
+	}
+}
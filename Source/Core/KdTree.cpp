@@ -0,0 +1,386 @@
+#include "Pargon/Math/KdTree.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+using namespace Pargon;
+
+namespace
+{
+	constexpr int _stackSize = 64;
+
+	auto Component(Point3 point, int axis) -> float
+	{
+		return axis == 0 ? point.X : (axis == 1 ? point.Y : point.Z);
+	}
+
+	struct Entry
+	{
+		Point3 Position;
+		int Index;
+	};
+
+	struct Candidate
+	{
+		float DistanceSquared;
+		int Index;
+	};
+
+	struct Range
+	{
+		int Start;
+		int End;
+		float DistanceSquared;
+	};
+
+	auto IsCloser(const Candidate& left, const Candidate& right) -> bool
+	{
+		return left.DistanceSquared < right.DistanceSquared;
+	}
+}
+
+struct KdTree::Data
+{
+	std::vector<Entry> Entries;
+	std::vector<std::uint8_t> Axes;
+
+	void Split(int start, int end);
+	void Search(Point3 point, int k, float epsilon, std::vector<Candidate>& candidates) const;
+};
+
+KdTree::KdTree() :
+	_data(std::make_unique<Data>())
+{
+}
+
+KdTree::KdTree(const KdTree& copy) :
+	_data(std::make_unique<Data>(*copy._data)),
+	_splitStages(copy._splitStages)
+{
+}
+
+KdTree::KdTree(KdTree&& move) noexcept = default;
+KdTree::~KdTree() = default;
+
+auto KdTree::operator=(const KdTree& copy) -> KdTree&
+{
+	if (!_data)
+		_data = std::make_unique<Data>(*copy._data);
+	else if (this != &copy)
+		*_data = *copy._data;
+
+	_splitStages = copy._splitStages;
+	return *this;
+}
+
+auto KdTree::operator=(KdTree&& move) noexcept -> KdTree&
+{
+	std::swap(_data, move._data);
+	std::swap(_splitStages, move._splitStages);
+	return *this;
+}
+
+auto KdTree::Count() const -> int
+{
+	return static_cast<int>(_data->Entries.size());
+}
+
+void KdTree::Build(const Point3* points, int count)
+{
+	BeginBuild(points, count);
+
+	for (auto stage = 0; stage < GetStageCount(); stage++)
+	{
+		for (auto task = 0; task < GetTaskCount(stage); task++)
+			BuildTask(stage, task);
+	}
+
+	EndBuild();
+}
+
+void KdTree::BeginBuild(const Point3* points, int count, int taskCount)
+{
+	assert(count >= 0);
+	assert(taskCount > 0);
+
+	_data->Entries.resize(count);
+	_data->Axes.assign(count, 0);
+	_splitStages = 0;
+
+	for (auto index = 0; index < count; index++)
+		_data->Entries[index] = { points[index], index };
+
+	// Each stage but the last splits every node at one depth, and the last builds the remaining subtrees.
+	while ((2 << _splitStages) <= taskCount)
+		_splitStages++;
+}
+
+auto KdTree::GetStageCount() const -> int
+{
+	return _splitStages + 1;
+}
+
+auto KdTree::GetTaskCount(int stage) const -> int
+{
+	assert(stage >= 0 && stage < GetStageCount());
+	return 1 << stage;
+}
+
+void KdTree::BuildTask(int stage, int task)
+{
+	assert(task >= 0 && task < GetTaskCount(stage));
+
+	int start, end;
+	GetRange(stage, task, start, end);
+
+	if (stage < _splitStages)
+	{
+		_data->Split(start, end);
+		return;
+	}
+
+	Range stack[_stackSize];
+	auto size = 0;
+
+	stack[size++] = { start, end, 0.0f };
+
+	while (size > 0)
+	{
+		auto range = stack[--size];
+
+		if (range.End - range.Start <= LeafSize)
+			continue;
+
+		_data->Split(range.Start, range.End);
+
+		auto middle = (range.Start + range.End) / 2;
+		stack[size++] = { range.Start, middle, 0.0f };
+		stack[size++] = { middle + 1, range.End, 0.0f };
+	}
+}
+
+void KdTree::EndBuild()
+{
+	// Every task sorts its own range in place so there is nothing left to link.
+}
+
+auto KdTree::FindNearest(Point3 point, float epsilon) const -> int
+{
+	auto result = -1;
+	FindNearest(&point, 1, &result, epsilon);
+	return result;
+}
+
+auto KdTree::FindNearest(Point3 point, int k, int* results, float epsilon) const -> int
+{
+	FindNearest(&point, 1, k, results, epsilon);
+	return static_cast<int>(std::find(results, results + k, -1) - results);
+}
+
+auto KdTree::FindInRadius(Point3 point, float radius, int* results, int capacity) const -> int
+{
+	int offsets[2];
+	return FindInRadius(&point, 1, radius, results, capacity, offsets);
+}
+
+void KdTree::FindNearest(const Point3* points, int count, int* results, float epsilon) const
+{
+	FindNearest(points, count, 1, results, epsilon);
+}
+
+void KdTree::FindNearest(const Point3* points, int count, int k, int* results, float epsilon) const
+{
+	assert(k > 0);
+
+	std::vector<Candidate> candidates;
+	candidates.reserve(k);
+
+	for (auto index = 0; index < count; index++)
+	{
+		_data->Search(points[index], k, epsilon, candidates);
+
+		auto output = results + static_cast<std::size_t>(index) * k;
+		auto found = static_cast<int>(candidates.size());
+
+		for (auto candidate = 0; candidate < k; candidate++)
+			output[candidate] = candidate < found ? candidates[candidate].Index : -1;
+	}
+}
+
+auto KdTree::FindInRadius(const Point3* points, int count, float radius, int* results, int capacity, int* offsets) const -> int
+{
+	auto& entries = _data->Entries;
+	auto& axes = _data->Axes;
+	auto radiusSquared = radius * radius;
+	auto total = 0;
+
+	auto add = [&](int result)
+	{
+		if (total < capacity)
+			results[total] = result;
+
+		total++;
+	};
+
+	for (auto index = 0; index < count; index++)
+	{
+		auto point = points[index];
+		Range stack[_stackSize];
+		auto size = 0;
+
+		offsets[index] = total;
+		stack[size++] = { 0, Count(), 0.0f };
+
+		while (size > 0)
+		{
+			auto range = stack[--size];
+
+			while (range.End - range.Start > LeafSize)
+			{
+				auto middle = (range.Start + range.End) / 2;
+				auto& entry = entries[middle];
+				auto axis = axes[middle];
+				auto delta = Component(point, axis) - Component(entry.Position, axis);
+
+				if ((entry.Position - point).GetLengthSquared() <= radiusSquared)
+					add(entry.Index);
+
+				if (delta * delta <= radiusSquared)
+					stack[size++] = delta < 0.0f ? Range{ middle + 1, range.End, 0.0f } : Range{ range.Start, middle, 0.0f };
+
+				range = delta < 0.0f ? Range{ range.Start, middle, 0.0f } : Range{ middle + 1, range.End, 0.0f };
+				assert(size < _stackSize);
+			}
+
+			for (auto entry = range.Start; entry < range.End; entry++)
+			{
+				if ((entries[entry].Position - point).GetLengthSquared() <= radiusSquared)
+					add(entries[entry].Index);
+			}
+		}
+	}
+
+	offsets[count] = total;
+	return total;
+}
+
+void KdTree::GetRange(int depth, int node, int& start, int& end) const
+{
+	start = 0;
+	end = Count();
+
+	for (auto bit = depth - 1; bit >= 0; bit--)
+	{
+		auto middle = (start + end) / 2;
+
+		if (end - start <= LeafSize)
+		{
+			start = end;
+			return;
+		}
+
+		if ((node >> bit) & 1)
+			start = middle + 1;
+		else
+			end = middle;
+	}
+}
+
+void KdTree::Data::Split(int start, int end)
+{
+	if (end - start <= LeafSize)
+		return;
+
+	auto minimum = Entries[start].Position;
+	auto maximum = minimum;
+
+	for (auto index = start + 1; index < end; index++)
+	{
+		auto position = Entries[index].Position;
+		minimum = { std::min(minimum.X, position.X), std::min(minimum.Y, position.Y), std::min(minimum.Z, position.Z) };
+		maximum = { std::max(maximum.X, position.X), std::max(maximum.Y, position.Y), std::max(maximum.Z, position.Z) };
+	}
+
+	auto size = maximum - minimum;
+	auto axis = size.X >= size.Y && size.X >= size.Z ? 0 : (size.Y >= size.Z ? 1 : 2);
+	auto middle = (start + end) / 2;
+
+	std::nth_element(Entries.begin() + start, Entries.begin() + middle, Entries.begin() + end, [axis](const Entry& left, const Entry& right)
+	{
+		return Component(left.Position, axis) < Component(right.Position, axis);
+	});
+
+	Axes[middle] = static_cast<std::uint8_t>(axis);
+}
+
+void KdTree::Data::Search(Point3 point, int k, float epsilon, std::vector<Candidate>& candidates) const
+{
+	assert(k > 0);
+	assert(epsilon >= 0.0f);
+
+	// Candidates are kept as a max heap on distance so the farthest is replaced first, and a subtree is skipped once
+	// the nearest it could hold, scaled by the epsilon, is no closer than the farthest candidate.
+
+	auto scale = (1.0f + epsilon) * (1.0f + epsilon);
+	auto worst = std::numeric_limits<float>::infinity();
+
+	auto consider = [&](const Entry& entry)
+	{
+		auto distanceSquared = (entry.Position - point).GetLengthSquared();
+
+		if (distanceSquared >= worst)
+			return;
+
+		if (static_cast<int>(candidates.size()) == k)
+		{
+			std::pop_heap(candidates.begin(), candidates.end(), IsCloser);
+			candidates.pop_back();
+		}
+
+		candidates.push_back({ distanceSquared, entry.Index });
+		std::push_heap(candidates.begin(), candidates.end(), IsCloser);
+
+		if (static_cast<int>(candidates.size()) == k)
+			worst = candidates.front().DistanceSquared;
+	};
+
+	Range stack[_stackSize];
+	auto size = 0;
+
+	candidates.clear();
+	stack[size++] = { 0, static_cast<int>(Entries.size()), 0.0f };
+
+	while (size > 0)
+	{
+		auto range = stack[--size];
+
+		if (range.DistanceSquared * scale >= worst)
+			continue;
+
+		while (range.End - range.Start > LeafSize)
+		{
+			auto middle = (range.Start + range.End) / 2;
+			auto& entry = Entries[middle];
+			auto axis = Axes[middle];
+			auto delta = Component(point, axis) - Component(entry.Position, axis);
+			auto farDistance = std::max(range.DistanceSquared, delta * delta);
+
+			consider(entry);
+
+			if (farDistance * scale < worst)
+				stack[size++] = delta < 0.0f ? Range{ middle + 1, range.End, farDistance } : Range{ range.Start, middle, farDistance };
+
+			range = delta < 0.0f ? Range{ range.Start, middle, range.DistanceSquared } : Range{ middle + 1, range.End, range.DistanceSquared };
+			assert(size < _stackSize);
+		}
+
+		for (auto entry = range.Start; entry < range.End; entry++)
+			consider(Entries[entry]);
+	}
+
+	std::sort_heap(candidates.begin(), candidates.end(), IsCloser);
+}
@@ -0,0 +1,583 @@
+#include "Pargon/Math/LooseTree.h"
+#include "Pargon/Math/Frustum.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace Pargon;
+
+namespace
+{
+	constexpr int _maximumDepthLimit = 16;
+	constexpr int _stackSize = 128;
+
+	auto GetLargestExtent(const Aabb2& bounds) -> float
+	{
+		auto extents = bounds.GetExtents();
+		return std::max(extents.X, extents.Y);
+	}
+
+	auto GetLargestExtent(const Aabb3& bounds) -> float
+	{
+		auto extents = bounds.GetExtents();
+		return std::max(std::max(extents.X, extents.Y), extents.Z);
+	}
+
+	auto ToCell(float value, float origin, float size, int cellCount, int& cell) -> bool
+	{
+		auto position = (value - origin) / size;
+
+		if (!(position >= 0.0f && position < 1.0f))
+			return false;
+
+		cell = std::min(static_cast<int>(position * cellCount), cellCount - 1);
+		return true;
+	}
+
+	auto GetCell(Point2 point, Point2 origin, float size, int cellCount, int (&cell)[3]) -> bool
+	{
+		cell[2] = 0;
+		return ToCell(point.X, origin.X, size, cellCount, cell[0]) & ToCell(point.Y, origin.Y, size, cellCount, cell[1]);
+	}
+
+	auto GetCell(Point3 point, Point3 origin, float size, int cellCount, int (&cell)[3]) -> bool
+	{
+		return ToCell(point.X, origin.X, size, cellCount, cell[0]) & ToCell(point.Y, origin.Y, size, cellCount, cell[1]) & ToCell(point.Z, origin.Z, size, cellCount, cell[2]);
+	}
+
+	// The loose bounds of a cell extend half a cell past each of its sides.
+
+	auto GetLooseBounds(Point2 origin, float cellSize, const int (&cell)[3]) -> Aabb2
+	{
+		auto minimum = Point2{ origin.X + (cell[0] - 0.5f) * cellSize, origin.Y + (cell[1] - 0.5f) * cellSize };
+		return { minimum, { minimum.X + 2.0f * cellSize, minimum.Y + 2.0f * cellSize } };
+	}
+
+	auto GetLooseBounds(Point3 origin, float cellSize, const int (&cell)[3]) -> Aabb3
+	{
+		auto minimum = Point3{ origin.X + (cell[0] - 0.5f) * cellSize, origin.Y + (cell[1] - 0.5f) * cellSize, origin.Z + (cell[2] - 0.5f) * cellSize };
+		return { minimum, { minimum.X + 2.0f * cellSize, minimum.Y + 2.0f * cellSize, minimum.Z + 2.0f * cellSize } };
+	}
+
+	auto GetDistanceSquared(const Aabb2& bounds, Point2 point) -> float
+	{
+		auto x = std::max(std::max(bounds.Minimum.X - point.X, point.X - bounds.Maximum.X), 0.0f);
+		auto y = std::max(std::max(bounds.Minimum.Y - point.Y, point.Y - bounds.Maximum.Y), 0.0f);
+		return x * x + y * y;
+	}
+
+	auto GetDistanceSquared(const Aabb3& bounds, Point3 point) -> float
+	{
+		auto x = std::max(std::max(bounds.Minimum.X - point.X, point.X - bounds.Maximum.X), 0.0f);
+		auto y = std::max(std::max(bounds.Minimum.Y - point.Y, point.Y - bounds.Maximum.Y), 0.0f);
+		auto z = std::max(std::max(bounds.Minimum.Z - point.Z, point.Z - bounds.Maximum.Z), 0.0f);
+		return x * x + y * y + z * z;
+	}
+
+	void WaitForReaders(const std::atomic<int>& readers)
+	{
+		while (readers.load() != 0)
+			std::this_thread::yield();
+	}
+
+	template<typename Query>
+	auto QueryBatch(int count, int* offsets, Query query) -> int
+	{
+		auto total = 0;
+
+		for (auto index = 0; index < count; index++)
+		{
+			offsets[index] = total;
+			query(index, total);
+		}
+
+		offsets[count] = total;
+		return total;
+	}
+
+	enum class ChangeType
+	{
+		Insert,
+		Move,
+		Remove
+	};
+}
+
+template<typename BoundsType>
+struct LooseTree<BoundsType>::Tree
+{
+	struct Node
+	{
+		BoundsType Bounds;
+		int Parent;
+		int FirstObject;
+		int Children[ChildCount];
+	};
+
+	struct Object
+	{
+		BoundsType Bounds;
+		int Node;
+		int Previous;
+		int Next;
+	};
+
+	std::vector<Node> Nodes;
+	std::vector<Object> Objects;
+	int FreeNode;
+	int FreeObject;
+	int ObjectCount;
+};
+
+template<typename BoundsType>
+struct LooseTree<BoundsType>::Change
+{
+	ChangeType Type;
+	int Object;
+	BoundsType Bounds;
+};
+
+template<typename BoundsType>
+struct LooseTree<BoundsType>::Data
+{
+	Tree Trees[2];
+	std::vector<Change> Changes;
+};
+
+template<typename BoundsType>
+LooseTree<BoundsType>::LooseTree(const BoundsType& world, int maximumDepth) :
+	_origin(world.Minimum),
+	_size(2.0f * GetLargestExtent(world)),
+	_maximumDepth(maximumDepth),
+	_data(std::make_unique<Data>())
+{
+	assert(_size > 0.0f);
+	assert(maximumDepth >= 0 && maximumDepth <= _maximumDepthLimit);
+
+	int cell[3] = { 0, 0, 0 };
+
+	for (auto& tree : _data->Trees)
+	{
+		tree.FreeNode = -1;
+		tree.FreeObject = InvalidObject;
+		tree.ObjectCount = 0;
+		AllocateNode(tree, -1, GetLooseBounds(_origin, _size, cell));
+	}
+
+	_front.store(0);
+	_version.store(0);
+	_readers[0].store(0);
+	_readers[1].store(0);
+}
+
+template<typename BoundsType>
+LooseTree<BoundsType>::~LooseTree() = default;
+
+template<typename BoundsType>
+auto LooseTree<BoundsType>::Insert(const BoundsType& bounds) -> int
+{
+	auto object = InsertObject(GetBack(), bounds);
+	_data->Changes.push_back({ ChangeType::Insert, object, bounds });
+	return object;
+}
+
+template<typename BoundsType>
+void LooseTree<BoundsType>::Move(int object, const BoundsType& bounds)
+{
+	MoveObject(GetBack(), object, bounds);
+	_data->Changes.push_back({ ChangeType::Move, object, bounds });
+}
+
+template<typename BoundsType>
+void LooseTree<BoundsType>::Remove(int object)
+{
+	RemoveObject(GetBack(), object);
+	_data->Changes.push_back({ ChangeType::Remove, object, {} });
+}
+
+template<typename BoundsType>
+void LooseTree<BoundsType>::Publish()
+{
+	// Readers register under the current version before reading the front, so once the front has changed and both
+	// versions have drained no reader can still be using the old front.
+
+	auto front = 1 - _front.load();
+	_front.store(front);
+
+	auto version = _version.load();
+	WaitForReaders(_readers[1 - version]);
+	_version.store(1 - version);
+	WaitForReaders(_readers[version]);
+
+	for (auto& change : _data->Changes)
+		Apply(_data->Trees[1 - front], change);
+
+	_data->Changes.clear();
+}
+
+template<typename BoundsType>
+auto LooseTree<BoundsType>::Count() const -> int
+{
+	auto count = 0;
+	ReadFront([&](const Tree& tree) { count = tree.ObjectCount; });
+	return count;
+}
+
+template<typename BoundsType>
+auto LooseTree<BoundsType>::QueryBox(const BoundsType& bounds, int* results, int capacity) const -> int
+{
+	return QueryBoxes(&bounds, 1, results, capacity, nullptr);
+}
+
+template<typename BoundsType>
+auto LooseTree<BoundsType>::QueryBoxes(const BoundsType* bounds, int count, int* results, int capacity, int* offsets) const -> int
+{
+	int singleOffsets[2];
+	auto total = 0;
+
+	ReadFront([&](const Tree& tree)
+	{
+		total = QueryBatch(count, offsets ? offsets : singleOffsets, [&](int index, int& found)
+		{
+			auto test = [&](const BoundsType& other) { return other.Overlaps(bounds[index]); };
+			Visit(tree, test, test, results, capacity, found);
+		});
+	});
+
+	return total;
+}
+
+template<typename BoundsType>
+auto LooseTree<BoundsType>::QuerySphere(PointType center, float radius, int* results, int capacity) const -> int
+{
+	return QuerySpheres(&center, &radius, 1, results, capacity, nullptr);
+}
+
+template<typename BoundsType>
+auto LooseTree<BoundsType>::QuerySpheres(const PointType* centers, const float* radii, int count, int* results, int capacity, int* offsets) const -> int
+{
+	int singleOffsets[2];
+	auto total = 0;
+
+	ReadFront([&](const Tree& tree)
+	{
+		total = QueryBatch(count, offsets ? offsets : singleOffsets, [&](int index, int& found)
+		{
+			auto test = [&](const BoundsType& other) { return GetDistanceSquared(other, centers[index]) <= radii[index] * radii[index]; };
+			Visit(tree, test, test, results, capacity, found);
+		});
+	});
+
+	return total;
+}
+
+template<typename BoundsType>
+template<typename Read>
+void LooseTree<BoundsType>::ReadFront(Read read) const
+{
+	auto version = _version.load();
+	_readers[version].fetch_add(1);
+	read(_data->Trees[_front.load()]);
+	_readers[version].fetch_sub(1);
+}
+
+template<typename BoundsType>
+template<typename NodeTest, typename ObjectTest>
+void LooseTree<BoundsType>::Visit(const Tree& tree, NodeTest nodeTest, ObjectTest objectTest, int* results, int capacity, int& total)
+{
+	int stack[_stackSize];
+	auto size = 0;
+
+	stack[size++] = 0;
+
+	while (size > 0)
+	{
+		auto index = stack[--size];
+		auto& node = tree.Nodes[index];
+
+		// The root is not tested since it also holds the objects outside the world bounds.
+		if (index != 0 && !nodeTest(node.Bounds))
+			continue;
+
+		for (auto object = node.FirstObject; object != InvalidObject; object = tree.Objects[object].Next)
+		{
+			if (objectTest(tree.Objects[object].Bounds))
+			{
+				if (total < capacity)
+					results[total] = object;
+
+				total++;
+			}
+		}
+
+		for (auto child : node.Children)
+		{
+			if (child >= 0)
+				stack[size++] = child;
+		}
+
+		assert(size <= _stackSize - ChildCount);
+	}
+}
+
+template<typename BoundsType>
+auto LooseTree<BoundsType>::GetBack() -> Tree&
+{
+	return _data->Trees[1 - _front.load(std::memory_order_relaxed)];
+}
+
+template<typename BoundsType>
+void LooseTree<BoundsType>::Apply(Tree& tree, const Change& change)
+{
+	switch (change.Type)
+	{
+		case ChangeType::Insert:
+		{
+			auto object = InsertObject(tree, change.Bounds);
+			assert(object == change.Object);
+			(void)object;
+			break;
+		}
+
+		case ChangeType::Move:
+		{
+			MoveObject(tree, change.Object, change.Bounds);
+			break;
+		}
+
+		case ChangeType::Remove:
+		{
+			RemoveObject(tree, change.Object);
+			break;
+		}
+	}
+}
+
+template<typename BoundsType>
+auto LooseTree<BoundsType>::InsertObject(Tree& tree, const BoundsType& bounds) -> int
+{
+	auto object = tree.FreeObject;
+
+	if (object != InvalidObject)
+	{
+		tree.FreeObject = tree.Objects[object].Next;
+	}
+	else
+	{
+		object = static_cast<int>(tree.Objects.size());
+		tree.Objects.emplace_back();
+	}
+
+	tree.Objects[object].Bounds = bounds;
+	tree.ObjectCount++;
+
+	Link(tree, object, FindNode(tree, bounds));
+	return object;
+}
+
+template<typename BoundsType>
+void LooseTree<BoundsType>::MoveObject(Tree& tree, int object, const BoundsType& bounds)
+{
+	assert(object >= 0 && object < static_cast<int>(tree.Objects.size()) && tree.Objects[object].Node >= 0);
+
+	auto node = tree.Objects[object].Node;
+	tree.Objects[object].Bounds = bounds;
+
+	// Objects in the root are always placed again since the root holds anything too large or too far out to go lower
+	// and one of those may have moved back into range.
+	if (node != 0 && tree.Nodes[node].Bounds.Contains(bounds))
+		return;
+
+	Unlink(tree, object);
+	Link(tree, object, FindNode(tree, bounds));
+	Prune(tree, node);
+}
+
+template<typename BoundsType>
+void LooseTree<BoundsType>::RemoveObject(Tree& tree, int object)
+{
+	assert(object >= 0 && object < static_cast<int>(tree.Objects.size()) && tree.Objects[object].Node >= 0);
+
+	auto node = tree.Objects[object].Node;
+
+	Unlink(tree, object);
+	tree.Objects[object].Node = -1;
+	tree.Objects[object].Next = tree.FreeObject;
+	tree.FreeObject = object;
+	tree.ObjectCount--;
+
+	Prune(tree, node);
+}
+
+template<typename BoundsType>
+auto LooseTree<BoundsType>::FindNode(Tree& tree, const BoundsType& bounds) -> int
+{
+	int cell[3] = {};
+
+	if (!GetCell(bounds.GetCenter(), _origin, _size, 1 << _maximumDepth, cell))
+		return 0;
+
+	auto getNodeCell = [&](int depth, int (&nodeCell)[3]) -> int
+	{
+		auto shift = _maximumDepth - depth;
+		auto slot = 0;
+
+		for (auto axis = 0; axis < Dimensions; axis++)
+		{
+			nodeCell[axis] = cell[axis] >> shift;
+			slot |= (nodeCell[axis] & 1) << axis;
+		}
+
+		if (Dimensions == 2)
+			nodeCell[2] = 0;
+
+		return slot;
+	};
+
+	auto radius = GetLargestExtent(bounds);
+	auto cellSize = _size;
+	auto depth = 0;
+
+	while (depth < _maximumDepth && radius <= cellSize * 0.25f)
+	{
+		depth++;
+		cellSize *= 0.5f;
+	}
+
+	// Rounding can leave an object a hair outside the node chosen for it, which queries would then miss, so the depth
+	// is settled before any nodes are allocated.
+
+	for (; depth > 0; depth--, cellSize *= 2.0f)
+	{
+		int nodeCell[3];
+		getNodeCell(depth, nodeCell);
+
+		if (GetLooseBounds(_origin, cellSize, nodeCell).Contains(bounds))
+			break;
+	}
+
+	auto node = 0;
+	cellSize = _size;
+
+	for (auto level = 1; level <= depth; level++)
+	{
+		int nodeCell[3];
+		auto slot = getNodeCell(level, nodeCell);
+		auto child = tree.Nodes[node].Children[slot];
+
+		cellSize *= 0.5f;
+
+		if (child < 0)
+		{
+			child = AllocateNode(tree, node, GetLooseBounds(_origin, cellSize, nodeCell));
+			tree.Nodes[node].Children[slot] = child;
+		}
+
+		node = child;
+	}
+
+	return node;
+}
+
+template<typename BoundsType>
+auto LooseTree<BoundsType>::AllocateNode(Tree& tree, int parent, const BoundsType& bounds) -> int
+{
+	auto node = tree.FreeNode;
+
+	if (node >= 0)
+	{
+		tree.FreeNode = tree.Nodes[node].FirstObject;
+	}
+	else
+	{
+		node = static_cast<int>(tree.Nodes.size());
+		tree.Nodes.emplace_back();
+	}
+
+	auto& entry = tree.Nodes[node];
+	entry.Bounds = bounds;
+	entry.Parent = parent;
+	entry.FirstObject = InvalidObject;
+	std::fill(std::begin(entry.Children), std::end(entry.Children), -1);
+
+	return node;
+}
+
+template<typename BoundsType>
+void LooseTree<BoundsType>::Link(Tree& tree, int object, int node)
+{
+	auto& entry = tree.Objects[object];
+	auto next = tree.Nodes[node].FirstObject;
+
+	entry.Node = node;
+	entry.Previous = InvalidObject;
+	entry.Next = next;
+
+	if (next != InvalidObject)
+		tree.Objects[next].Previous = object;
+
+	tree.Nodes[node].FirstObject = object;
+}
+
+template<typename BoundsType>
+void LooseTree<BoundsType>::Unlink(Tree& tree, int object)
+{
+	auto& entry = tree.Objects[object];
+
+	if (entry.Previous != InvalidObject)
+		tree.Objects[entry.Previous].Next = entry.Next;
+	else
+		tree.Nodes[entry.Node].FirstObject = entry.Next;
+
+	if (entry.Next != InvalidObject)
+		tree.Objects[entry.Next].Previous = entry.Previous;
+}
+
+template<typename BoundsType>
+void LooseTree<BoundsType>::Prune(Tree& tree, int node)
+{
+	while (node != 0 && tree.Nodes[node].FirstObject == InvalidObject)
+	{
+		auto& entry = tree.Nodes[node];
+
+		if (std::any_of(std::begin(entry.Children), std::end(entry.Children), [](int child) { return child >= 0; }))
+			break;
+
+		auto parent = entry.Parent;
+		auto& children = tree.Nodes[parent].Children;
+		*std::find(std::begin(children), std::end(children), node) = -1;
+
+		entry.FirstObject = tree.FreeNode;
+		tree.FreeNode = node;
+		node = parent;
+	}
+}
+
+auto Octree::QueryFrustum(const Frustum& frustum, int* results, int capacity) const -> int
+{
+	return QueryFrustums(&frustum, 1, results, capacity, nullptr);
+}
+
+auto Octree::QueryFrustums(const Frustum* frustums, int count, int* results, int capacity, int* offsets) const -> int
+{
+	int singleOffsets[2];
+	auto total = 0;
+
+	ReadFront([&](const Tree& tree)
+	{
+		total = QueryBatch(count, offsets ? offsets : singleOffsets, [&](int index, int& found)
+		{
+			auto test = [&](const Aabb3& bounds) { return frustums[index].IntersectsBox(bounds.GetCenter(), bounds.GetExtents()); };
+			Visit(tree, test, test, results, capacity, found);
+		});
+	});
+
+	return total;
+}
+
+template class Pargon::LooseTree<Aabb2>;
+template class Pargon::LooseTree<Aabb3>;
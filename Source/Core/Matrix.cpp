@@ -6,33 +6,478 @@
 #include "Pargon/Serialization/BufferWriter.h"
 #include "Pargon/Serialization/StringReader.h"
 #include "Pargon/Serialization/StringWriter.h"
+#include "Core/Simd.h"
 
 #include <algorithm>
+#include <cmath>
 #include <cml/cml.h>
 
 using namespace Pargon;
 
+namespace
+{
+	void Multiply4x4(const float* left, const float* right, float* result)
+	{
+#if PARGON_MATH_AVX
+		auto right0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(right + 0));
+		auto right1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(right + 4));
+		auto right2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(right + 8));
+		auto right3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(right + 12));
+
+		auto rows01 = Simd::MultiplyRows(_mm256_loadu_ps(left + 0), right0, right1, right2, right3);
+		auto rows23 = Simd::MultiplyRows(_mm256_loadu_ps(left + 8), right0, right1, right2, right3);
+
+		_mm256_storeu_ps(result + 0, rows01);
+		_mm256_storeu_ps(result + 8, rows23);
+#elif PARGON_MATH_SSE
+		auto right0 = _mm_loadu_ps(right + 0);
+		auto right1 = _mm_loadu_ps(right + 4);
+		auto right2 = _mm_loadu_ps(right + 8);
+		auto right3 = _mm_loadu_ps(right + 12);
+
+		auto row0 = Simd::MultiplyRow(_mm_loadu_ps(left + 0), right0, right1, right2, right3);
+		auto row1 = Simd::MultiplyRow(_mm_loadu_ps(left + 4), right0, right1, right2, right3);
+		auto row2 = Simd::MultiplyRow(_mm_loadu_ps(left + 8), right0, right1, right2, right3);
+		auto row3 = Simd::MultiplyRow(_mm_loadu_ps(left + 12), right0, right1, right2, right3);
+
+		_mm_storeu_ps(result + 0, row0);
+		_mm_storeu_ps(result + 4, row1);
+		_mm_storeu_ps(result + 8, row2);
+		_mm_storeu_ps(result + 12, row3);
+#else
+		float product[16];
+
+		for (auto row = 0; row < 4; row++)
+		{
+			for (auto column = 0; column < 4; column++)
+			{
+				auto sum = left[row * 4] * right[column];
+
+				for (auto index = 1; index < 4; index++)
+					sum += left[row * 4 + index] * right[index * 4 + column];
+
+				product[row * 4 + column] = sum;
+			}
+		}
+
+		std::copy(product, product + 16, result);
+#endif
+	}
+
+	void InvertAffine4x4(float* matrix)
+	{
+#if PARGON_MATH_SSE
+		auto row0 = _mm_loadu_ps(matrix + 0);
+		auto row1 = _mm_loadu_ps(matrix + 4);
+		auto row2 = _mm_loadu_ps(matrix + 8);
+		auto translation = _mm_loadu_ps(matrix + 12);
+
+		auto inverse0 = Simd::Cross(row1, row2);
+		auto inverse1 = Simd::Cross(row2, row0);
+		auto inverse2 = Simd::Cross(row0, row1);
+		auto inverse3 = _mm_setzero_ps();
+		auto determinant = _mm_div_ps(_mm_set1_ps(1.0f), Simd::Dot3(row0, inverse0));
+
+		_MM_TRANSPOSE4_PS(inverse0, inverse1, inverse2, inverse3);
+
+		inverse0 = _mm_mul_ps(inverse0, determinant);
+		inverse1 = _mm_mul_ps(inverse1, determinant);
+		inverse2 = _mm_mul_ps(inverse2, determinant);
+
+		auto offset = _mm_mul_ps(Simd::Splat<0>(translation), inverse0);
+		offset = Simd::MultiplyAdd(Simd::Splat<1>(translation), inverse1, offset);
+		offset = Simd::MultiplyAdd(Simd::Splat<2>(translation), inverse2, offset);
+		inverse3 = _mm_sub_ps(_mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f), offset);
+
+		_mm_storeu_ps(matrix + 0, inverse0);
+		_mm_storeu_ps(matrix + 4, inverse1);
+		_mm_storeu_ps(matrix + 8, inverse2);
+		_mm_storeu_ps(matrix + 12, inverse3);
+#else
+		float inverse[16] =
+		{
+			matrix[5] * matrix[10] - matrix[6] * matrix[9], matrix[9] * matrix[2] - matrix[10] * matrix[1], matrix[1] * matrix[6] - matrix[2] * matrix[5], 0.0f,
+			matrix[6] * matrix[8] - matrix[4] * matrix[10], matrix[10] * matrix[0] - matrix[8] * matrix[2], matrix[2] * matrix[4] - matrix[0] * matrix[6], 0.0f,
+			matrix[4] * matrix[9] - matrix[5] * matrix[8], matrix[8] * matrix[1] - matrix[9] * matrix[0], matrix[0] * matrix[5] - matrix[1] * matrix[4], 0.0f,
+			0.0f, 0.0f, 0.0f, 1.0f
+		};
+
+		auto determinant = 1.0f / (matrix[0] * inverse[0] + matrix[1] * inverse[4] + matrix[2] * inverse[8]);
+
+		for (auto row = 0; row < 3; row++)
+		{
+			for (auto column = 0; column < 3; column++)
+			{
+				inverse[row * 4 + column] *= determinant;
+				inverse[12 + column] -= matrix[12 + row] * inverse[row * 4 + column];
+			}
+		}
+
+		std::copy(inverse, inverse + 16, matrix);
+#endif
+	}
+
+	void InvertGeneral4x4(float* matrix)
+	{
+#if PARGON_MATH_SSE
+		// Cramer's rule evaluated on the four 2x2 blocks of the matrix, each packed into one register.
+
+		auto row0 = _mm_loadu_ps(matrix + 0);
+		auto row1 = _mm_loadu_ps(matrix + 4);
+		auto row2 = _mm_loadu_ps(matrix + 8);
+		auto row3 = _mm_loadu_ps(matrix + 12);
+
+		auto multiply = [](__m128 left, __m128 right)
+		{
+			return _mm_add_ps(_mm_mul_ps(left, Simd::Swizzle<0, 3, 0, 3>(right)), _mm_mul_ps(Simd::Swizzle<1, 0, 3, 2>(left), Simd::Swizzle<2, 1, 2, 1>(right)));
+		};
+
+		auto adjugateMultiply = [](__m128 left, __m128 right)
+		{
+			return _mm_sub_ps(_mm_mul_ps(Simd::Swizzle<3, 3, 0, 0>(left), right), _mm_mul_ps(Simd::Swizzle<1, 1, 2, 2>(left), Simd::Swizzle<2, 3, 0, 1>(right)));
+		};
+
+		auto multiplyAdjugate = [](__m128 left, __m128 right)
+		{
+			return _mm_sub_ps(_mm_mul_ps(left, Simd::Swizzle<3, 0, 3, 0>(right)), _mm_mul_ps(Simd::Swizzle<1, 0, 3, 2>(left), Simd::Swizzle<2, 1, 2, 1>(right)));
+		};
+
+		auto a = _mm_movelh_ps(row0, row1);
+		auto b = _mm_movehl_ps(row1, row0);
+		auto c = _mm_movelh_ps(row2, row3);
+		auto d = _mm_movehl_ps(row3, row2);
+
+		auto determinants = _mm_sub_ps(
+			_mm_mul_ps(Simd::Shuffle<0, 2, 0, 2>(row0, row2), Simd::Shuffle<1, 3, 1, 3>(row1, row3)),
+			_mm_mul_ps(Simd::Shuffle<1, 3, 1, 3>(row0, row2), Simd::Shuffle<0, 2, 0, 2>(row1, row3)));
+
+		auto determinantA = Simd::Splat<0>(determinants);
+		auto determinantB = Simd::Splat<1>(determinants);
+		auto determinantC = Simd::Splat<2>(determinants);
+		auto determinantD = Simd::Splat<3>(determinants);
+
+		auto dc = adjugateMultiply(d, c);
+		auto ab = adjugateMultiply(a, b);
+		auto x = _mm_sub_ps(_mm_mul_ps(determinantD, a), multiply(b, dc));
+		auto w = _mm_sub_ps(_mm_mul_ps(determinantA, d), multiply(c, ab));
+		auto y = _mm_sub_ps(_mm_mul_ps(determinantB, c), multiplyAdjugate(d, ab));
+		auto z = _mm_sub_ps(_mm_mul_ps(determinantC, b), multiplyAdjugate(a, dc));
+
+		auto trace = _mm_mul_ps(ab, Simd::Swizzle<0, 2, 1, 3>(dc));
+		trace = _mm_add_ps(trace, Simd::Swizzle<2, 3, 0, 1>(trace));
+		trace = _mm_add_ps(trace, Simd::Swizzle<1, 0, 3, 2>(trace));
+
+		auto determinant = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(determinantA, determinantD), _mm_mul_ps(determinantB, determinantC)), trace);
+		auto inverseDeterminant = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), determinant);
+
+		x = _mm_mul_ps(x, inverseDeterminant);
+		y = _mm_mul_ps(y, inverseDeterminant);
+		z = _mm_mul_ps(z, inverseDeterminant);
+		w = _mm_mul_ps(w, inverseDeterminant);
+
+		_mm_storeu_ps(matrix + 0, Simd::Shuffle<3, 1, 3, 1>(x, y));
+		_mm_storeu_ps(matrix + 4, Simd::Shuffle<2, 0, 2, 0>(x, y));
+		_mm_storeu_ps(matrix + 8, Simd::Shuffle<3, 1, 3, 1>(z, w));
+		_mm_storeu_ps(matrix + 12, Simd::Shuffle<2, 0, 2, 0>(z, w));
+#else
+		cml::matrix<float, cml::external<4, 4>, cml::row_basis, cml::row_major> m(matrix);
+		m.inverse();
+#endif
+	}
+
+	auto Cross(Vector3 left, Vector3 right) -> Vector3
+	{
+		return { left.Y * right.Z - left.Z * right.Y, left.Z * right.X - left.X * right.Z, left.X * right.Y - left.Y * right.X };
+	}
+
+	auto DecomposeTransform(const Matrix4x4& matrix, TransformDecomposition decomposition) -> Matrix4x4::Transform
+	{
+		auto& elements = matrix.Elements;
+
+		auto row0 = Vector3{ elements.Item(0), elements.Item(1), elements.Item(2) };
+		auto row1 = Vector3{ elements.Item(4), elements.Item(5), elements.Item(6) };
+		auto row2 = Vector3{ elements.Item(8), elements.Item(9), elements.Item(10) };
+
+		Matrix4x4::Transform transform;
+		transform.Translation = { elements.Item(12), elements.Item(13), elements.Item(14) };
+
+		// A row with no length has no direction to normalize or orthogonalize against, so it keeps a scale of 0 and
+		// its rotation axis is filled in from the other two afterwards.
+
+		transform.Scale.X = std::sqrt(row0.GetLengthSquared());
+
+		if (transform.Scale.X > 0.0f)
+			row0 = row0 * (1.0f / transform.Scale.X);
+
+		if (decomposition == TransformDecomposition::RemoveShear && transform.Scale.X > 0.0f)
+			row1 = row1 - row0 * row1.GetDotProduct(row0);
+
+		transform.Scale.Y = std::sqrt(row1.GetLengthSquared());
+
+		if (transform.Scale.Y > 0.0f)
+			row1 = row1 * (1.0f / transform.Scale.Y);
+
+		auto cross = Cross(row0, row1);
+		auto determinant = row2.GetDotProduct(cross);
+
+		if (decomposition == TransformDecomposition::RemoveShear && transform.Scale.X > 0.0f && transform.Scale.Y > 0.0f)
+		{
+			transform.Scale.Z = determinant;
+			row2 = cross;
+		}
+		else
+		{
+			if (decomposition == TransformDecomposition::RemoveShear)
+				row2 = row2 - row0 * row2.GetDotProduct(row0) - row1 * row2.GetDotProduct(row1);
+
+			transform.Scale.Z = std::copysign(std::sqrt(row2.GetLengthSquared()), determinant);
+
+			if (transform.Scale.Z != 0.0f)
+				row2 = row2 * (1.0f / transform.Scale.Z);
+		}
+
+		if (transform.Scale.X == 0.0f)
+			row0 = Cross(row1, row2);
+
+		if (transform.Scale.Y == 0.0f)
+			row1 = Cross(row2, row0);
+
+		if (transform.Scale.Z == 0.0f)
+			row2 = Cross(row0, row1);
+
+		auto& rotation = transform.Rotation;
+		auto trace = 0.0f;
+
+		if (row2.Z < 0.0f)
+		{
+			if (row0.X > row1.Y)
+			{
+				trace = 1.0f + row0.X - row1.Y - row2.Z;
+				rotation = { trace, row0.Y + row1.X, row2.X + row0.Z, row1.Z - row2.Y };
+			}
+			else
+			{
+				trace = 1.0f - row0.X + row1.Y - row2.Z;
+				rotation = { row0.Y + row1.X, trace, row1.Z + row2.Y, row2.X - row0.Z };
+			}
+		}
+		else
+		{
+			if (row0.X < -row1.Y)
+			{
+				trace = 1.0f - row0.X - row1.Y + row2.Z;
+				rotation = { row2.X + row0.Z, row1.Z + row2.Y, trace, row0.Y - row1.X };
+			}
+			else
+			{
+				trace = 1.0f + row0.X + row1.Y + row2.Z;
+				rotation = { row1.Z - row2.Y, row2.X - row0.Z, row0.Y - row1.X, trace };
+			}
+		}
+
+		// The unscaled quaternion has a length of twice the square root of the trace, and normalizing it directly also
+		// keeps a rotation built from a degenerate basis valid.
+
+		auto length = std::sqrt(rotation.X * rotation.X + rotation.Y * rotation.Y + rotation.Z * rotation.Z + rotation.W * rotation.W);
+
+		if (length > 0.0f)
+		{
+			auto factor = 1.0f / length;
+
+			rotation.X *= factor;
+			rotation.Y *= factor;
+			rotation.Z *= factor;
+			rotation.W *= factor;
+		}
+		else
+		{
+			rotation = { 0.0f, 0.0f, 0.0f, 1.0f };
+		}
+
+		return transform;
+	}
+
+#if PARGON_MATH_SSE
+	auto RowData(const Matrix4x4* matrices, int count, int lane, int row) -> const float*
+	{
+		return matrices[lane < count ? lane : 0].Elements.begin() + row * 4;
+	}
+
+	void LoadRow(const Matrix4x4* matrices, int count, int row, Simd::Wide& x, Simd::Wide& y, Simd::Wide& z)
+	{
+		Simd::Wide columns[4];
+
+		for (auto index = 0; index < 4; index++)
+		{
+#if PARGON_MATH_AVX
+			columns[index].Value = _mm256_set_m128(_mm_loadu_ps(RowData(matrices, count, index + 4, row)), _mm_loadu_ps(RowData(matrices, count, index, row)));
+#else
+			columns[index].Value = _mm_loadu_ps(RowData(matrices, count, index, row));
+#endif
+		}
+
+		Simd::Transpose4(columns[0], columns[1], columns[2], columns[3]);
+
+		x = columns[0];
+		y = columns[1];
+		z = columns[2];
+	}
+
+	void DecomposeTransformBlock(const Matrix4x4* matrices, int count, Matrix4x4::Transform* results, TransformDecomposition decomposition)
+	{
+		Simd::Wide x0, y0, z0, x1, y1, z1, x2, y2, z2;
+
+		LoadRow(matrices, count, 0, x0, y0, z0);
+		LoadRow(matrices, count, 1, x1, y1, z1);
+		LoadRow(matrices, count, 2, x2, y2, z2);
+
+		// Rows with no length are handled the same way as in DecomposeTransform, with selects in place of branches.
+		// Their inverse is 0 so they stay zero and have no effect when other rows are orthogonalized against them.
+
+		auto zero = Simd::Wide::Broadcast(0.0f);
+		auto one = Simd::Wide::Broadcast(1.0f);
+		auto scale0 = Simd::SquareRoot(x0 * x0 + y0 * y0 + z0 * z0);
+		auto valid0 = Simd::GreaterThan(scale0, zero);
+		auto inverse0 = Simd::Select(valid0, one / scale0, zero);
+
+		x0 = x0 * inverse0;
+		y0 = y0 * inverse0;
+		z0 = z0 * inverse0;
+
+		if (decomposition == TransformDecomposition::RemoveShear)
+		{
+			auto shear = x1 * x0 + y1 * y0 + z1 * z0;
+
+			x1 = x1 - shear * x0;
+			y1 = y1 - shear * y0;
+			z1 = z1 - shear * z0;
+		}
+
+		auto scale1 = Simd::SquareRoot(x1 * x1 + y1 * y1 + z1 * z1);
+		auto valid1 = Simd::GreaterThan(scale1, zero);
+		auto inverse1 = Simd::Select(valid1, one / scale1, zero);
+
+		x1 = x1 * inverse1;
+		y1 = y1 * inverse1;
+		z1 = z1 * inverse1;
+
+		auto crossX = y0 * z1 - z0 * y1;
+		auto crossY = z0 * x1 - x0 * z1;
+		auto crossZ = x0 * y1 - y0 * x1;
+		auto determinant = x2 * crossX + y2 * crossY + z2 * crossZ;
+
+		if (decomposition == TransformDecomposition::RemoveShear)
+		{
+			auto shear0 = x2 * x0 + y2 * y0 + z2 * z0;
+			auto shear1 = x2 * x1 + y2 * y1 + z2 * z1;
+
+			x2 = x2 - shear0 * x0 - shear1 * x1;
+			y2 = y2 - shear0 * y0 - shear1 * y1;
+			z2 = z2 - shear0 * z0 - shear1 * z1;
+		}
+
+		auto scale2 = Simd::CopySign(Simd::SquareRoot(x2 * x2 + y2 * y2 + z2 * z2), determinant);
+		auto valid2 = Simd::GreaterThan(Simd::AbsoluteValue(scale2), zero);
+		auto inverse2 = Simd::Select(valid2, one / scale2, zero);
+
+		x2 = x2 * inverse2;
+		y2 = y2 * inverse2;
+		z2 = z2 * inverse2;
+
+		if (decomposition == TransformDecomposition::RemoveShear)
+		{
+			auto orthogonal = valid0 & valid1;
+
+			scale2 = Simd::Select(orthogonal, determinant, scale2);
+			valid2 = valid2 | orthogonal;
+			x2 = Simd::Select(orthogonal, crossX, x2);
+			y2 = Simd::Select(orthogonal, crossY, y2);
+			z2 = Simd::Select(orthogonal, crossZ, z2);
+		}
+
+		x0 = Simd::Select(valid0, x0, y1 * z2 - z1 * y2);
+		y0 = Simd::Select(valid0, y0, z1 * x2 - x1 * z2);
+		z0 = Simd::Select(valid0, z0, x1 * y2 - y1 * x2);
+		x1 = Simd::Select(valid1, x1, y2 * z0 - z2 * y0);
+		y1 = Simd::Select(valid1, y1, z2 * x0 - x2 * z0);
+		z1 = Simd::Select(valid1, z1, x2 * y0 - y2 * x0);
+		x2 = Simd::Select(valid2, x2, y0 * z1 - z0 * y1);
+		y2 = Simd::Select(valid2, y2, z0 * x1 - x0 * z1);
+		z2 = Simd::Select(valid2, z2, x0 * y1 - y0 * x1);
+
+		auto sum01 = y0 + x1, sum20 = x2 + z0, sum12 = z1 + y2;
+		auto difference12 = z1 - y2, difference20 = x2 - z0, difference01 = y0 - x1;
+
+		auto traceX = one + x0 - y1 - z2;
+		auto traceY = one - x0 + y1 - z2;
+		auto traceZ = one - x0 - y1 + z2;
+		auto traceW = one + x0 + y1 + z2;
+
+		auto negativeZ = Simd::LessThan(z2, zero);
+		auto largestX = Simd::GreaterThan(x0, y1);
+		auto largestZ = Simd::LessThan(x0, zero - y1);
+
+		auto x = Simd::Select(negativeZ, Simd::Select(largestX, traceX, sum01), Simd::Select(largestZ, sum20, difference12));
+		auto y = Simd::Select(negativeZ, Simd::Select(largestX, sum01, traceY), Simd::Select(largestZ, sum12, difference20));
+		auto z = Simd::Select(negativeZ, Simd::Select(largestX, sum20, sum12), Simd::Select(largestZ, traceZ, difference01));
+		auto w = Simd::Select(negativeZ, Simd::Select(largestX, difference12, difference20), Simd::Select(largestZ, difference01, traceW));
+
+		auto length = Simd::SquareRoot(x * x + y * y + z * z + w * w);
+		auto nonzero = Simd::GreaterThan(length, zero);
+		auto factor = Simd::Select(nonzero, one / length, zero);
+
+		w = Simd::Select(nonzero, w, one);
+		factor = Simd::Select(nonzero, factor, one);
+
+		alignas(32) float values[7][Simd::Wide::Width];
+
+		scale0.Store(values[0]);
+		scale1.Store(values[1]);
+		scale2.Store(values[2]);
+		(x * factor).Store(values[3]);
+		(y * factor).Store(values[4]);
+		(z * factor).Store(values[5]);
+		(w * factor).Store(values[6]);
+
+		for (auto lane = 0; lane < count; lane++)
+		{
+			auto& matrix = matrices[lane];
+
+			results[lane].Translation = { matrix.Elements.Item(12), matrix.Elements.Item(13), matrix.Elements.Item(14) };
+			results[lane].Scale = { values[0][lane], values[1][lane], values[2][lane] };
+			results[lane].Rotation = { values[3][lane], values[4][lane], values[5][lane], values[6][lane] };
+		}
+	}
+#endif
+}
+
 auto Matrix3x3::CreateRotation(Rotation angle) -> Matrix3x3
 {
-	auto sine = Sine(angle);
-	auto cosine = Cosine(angle);
+	auto rotation = SineCosine(angle);
 
 	return
 	{
-		cosine, -sine, 0.0f,
-		sine, cosine, 0.0f,
+		rotation.Cosine, -rotation.Sine, 0.0f,
+		rotation.Sine, rotation.Cosine, 0.0f,
 		0.0f, 0.0f, 1.0f
 	};
 }
 
 auto Matrix3x3::CreateTransform(Vector2 translation, Vector2 scale, Rotation angle, Vector2 offset) -> Matrix3x3
 {
-	auto matrix = CreateTranslation(-offset);
-	matrix.Scale(scale);
-	matrix.Rotate(angle);
-	matrix.Translate(translation);
+	auto rotation = SineCosine(angle);
 
-	return matrix;
+	auto row1column1 = rotation.Cosine * scale.X;
+	auto row1column2 = rotation.Sine * scale.X;
+	auto row2column1 = -rotation.Sine * scale.Y;
+	auto row2column2 = rotation.Cosine * scale.Y;
+
+	return
+	{
+		row1column1, row1column2, 0.0f,
+		row2column1, row2column2, 0.0f,
+		translation.X - (offset.X * row1column1 + offset.Y * row2column1), translation.Y - (offset.X * row1column2 + offset.Y * row2column2), 1.0f
+	};
 }
 
 auto Matrix3x3::operator==(const Matrix3x3& right) const -> bool
@@ -241,12 +686,26 @@ auto Matrix4x4::CreateRotation(Quaternion rotation) -> Matrix4x4
 
 auto Matrix4x4::CreateTransform(Vector3 translation, Vector3 scale, Quaternion rotation, Vector3 offset) -> Matrix4x4
 {
-	auto matrix = CreateTranslation(-offset);
-	matrix.Scale(scale);
-	matrix.Rotate(rotation);
-	matrix.Translate(translation + offset);
+	auto x2 = rotation.X + rotation.X;
+	auto y2 = rotation.Y + rotation.Y;
+	auto z2 = rotation.Z + rotation.Z;
 
-	return matrix;
+	auto xx2 = rotation.X * x2, yy2 = rotation.Y * y2, zz2 = rotation.Z * z2;
+	auto xy2 = rotation.X * y2, yz2 = rotation.Y * z2, zx2 = rotation.Z * x2;
+	auto xw2 = rotation.W * x2, yw2 = rotation.W * y2, zw2 = rotation.W * z2;
+
+	auto row1 = Vector3{ 1.0f - yy2 - zz2, xy2 + zw2, zx2 - yw2 } * scale.X;
+	auto row2 = Vector3{ xy2 - zw2, 1.0f - zz2 - xx2, yz2 + xw2 } * scale.Y;
+	auto row3 = Vector3{ zx2 + yw2, yz2 - xw2, 1.0f - xx2 - yy2 } * scale.Z;
+	auto row4 = translation + offset - (row1 * offset.X + row2 * offset.Y + row3 * offset.Z);
+
+	return
+	{
+		row1.X, row1.Y, row1.Z, 0.0f,
+		row2.X, row2.Y, row2.Z, 0.0f,
+		row3.X, row3.Y, row3.Z, 0.0f,
+		row4.X, row4.Y, row4.Z, 1.0f
+	};
 }
 
 auto Matrix4x4::CreatePerspectiveProjection(Angle angle, float aspectRatio, float nearPlane, float farPlane) -> Matrix4x4
@@ -279,21 +738,14 @@ auto Matrix4x4::operator!=(const Matrix4x4& right) const -> bool
 
 auto Matrix4x4::operator*=(const Matrix4x4& right) -> Matrix4x4&
 {
-	cml::matrix<float, cml::external<4, 4>, cml::row_basis, cml::row_major> l(Elements.begin());
-	cml::matrix<float, cml::external<4, 4>, cml::row_basis, cml::row_major> r(const_cast<float*>(right.Elements.begin()));
-
-	l *= r;
+	Multiply4x4(Elements.begin(), right.Elements.begin(), Elements.begin());
 	return *this;
 }
 
 auto Matrix4x4::operator*(const Matrix4x4& right) const -> Matrix4x4
 {
 	Matrix4x4 matrix;
-	cml::matrix<float, cml::external<4, 4>, cml::row_basis, cml::row_major> m(matrix.Elements.begin());
-	cml::matrix<float, cml::external<4, 4>, cml::row_basis, cml::row_major> l(const_cast<float*>(Elements.begin()));
-	cml::matrix<float, cml::external<4, 4>, cml::row_basis, cml::row_major> r(const_cast<float*>(right.Elements.begin()));
-
-	m = l * r;
+	Multiply4x4(Elements.begin(), right.Elements.begin(), matrix.Elements.begin());
 	return matrix;
 }
 
@@ -309,6 +761,11 @@ void Matrix4x4::Set(int row, int column, float value)
 	Elements.Item(row * 4 + column) = value;
 }
 
+auto Matrix4x4::IsAffine() const -> bool
+{
+	return Elements.Item(3) == 0.0f && Elements.Item(7) == 0.0f && Elements.Item(11) == 0.0f && Elements.Item(15) == 1.0f;
+}
+
 auto Matrix4x4::GetDeterminant() const -> float
 {
 	cml::matrix<float, cml::external<4, 4>, cml::row_basis, cml::row_major> m(const_cast<float*>(Elements.begin()));
@@ -323,54 +780,19 @@ auto Matrix4x4::GetTranslation() const -> Vector3
 	return { result[0], result[1], result[2] };
 }
 
-auto Matrix4x4::GetScale() const -> Vector3
+auto Matrix4x4::GetScale(TransformDecomposition decomposition) const -> Vector3
 {
-	cml::matrix<float, cml::external<4, 4>, cml::row_basis, cml::row_major> m(const_cast<float*>(Elements.begin()));
-	cml::vector3f translation;
-	cml::quaternionf_n quaternion;
-
-	Vector3 scale;
-	cml::matrix_decompose_SRT(m, scale.X, scale.Y, scale.Z, quaternion, translation);
-
-	return scale;
+	return GetTransform(decomposition).Scale;
 }
 
-auto Matrix4x4::GetRotation() const -> Quaternion
+auto Matrix4x4::GetRotation(TransformDecomposition decomposition) const -> Quaternion
 {
-	cml::matrix<float, cml::external<4, 4>, cml::row_basis, cml::row_major> m(const_cast<float*>(Elements.begin()));
-	cml::quaternionf_n quaternion;
-	cml::vector3f translation, scale;
-	cml::matrix_decompose_SRT(m, scale[0], scale[1], scale[2], quaternion, translation);
-
-	return 
-	{
-		quaternion[0],
-		quaternion[1],
-		quaternion[2],
-		quaternion[3]
-	};
+	return GetTransform(decomposition).Rotation;
 }
 
-auto Matrix4x4::GetTransform() const -> Transform
+auto Matrix4x4::GetTransform(TransformDecomposition decomposition) const -> Transform
 {
-	Transform transform;
-
-	cml::matrix<float, cml::external<4, 4>, cml::row_basis, cml::row_major> m(const_cast<float*>(Elements.begin()));
-	cml::quaternionf_n q;
-	cml::vector3f t;
-
-	cml::matrix_decompose_SRT(m, transform.Scale.X, transform.Scale.Y, transform.Scale.Z, q, t);
-
-	transform.Translation.X = t[0];
-	transform.Translation.Y = t[1];
-	transform.Translation.Z = t[2];
-
-	transform.Rotation.X = q[0];
-	transform.Rotation.Y = q[1];
-	transform.Rotation.Z = q[2];
-	transform.Rotation.W = q[3];
-
-	return transform;
+	return DecomposeTransform(*this, decomposition);
 }
 
 auto Matrix4x4::Get3x3() const -> Matrix3x3
@@ -385,8 +807,16 @@ auto Matrix4x4::Get3x3() const -> Matrix3x3
 
 void Matrix4x4::Invert()
 {
-	cml::matrix<float, cml::external<4, 4>, cml::row_basis, cml::row_major> matrix(Elements.begin());
-	matrix.inverse();
+	if (IsAffine())
+		InvertAffine4x4(Elements.begin());
+	else
+		InvertGeneral4x4(Elements.begin());
+}
+
+void Matrix4x4::InvertAffine()
+{
+	assert(IsAffine());
+	InvertAffine4x4(Elements.begin());
 }
 
 void Matrix4x4::Transpose()
@@ -430,6 +860,13 @@ auto Matrix4x4::Inverted() const -> Matrix4x4
 	return copy;
 }
 
+auto Matrix4x4::InvertedAffine() const -> Matrix4x4
+{
+	auto copy = *this;
+	copy.InvertAffine();
+	return copy;
+}
+
 auto Matrix4x4::Transposed() const -> Matrix4x4
 {
 	auto copy = *this;
@@ -477,3 +914,70 @@ void Matrix4x4::FromString(StringReader& reader, StringView format)
 {
 	reader.Read(Elements, format);
 }
+
+void Pargon::BuildTransforms(const Vector2* translations, const Vector2* scales, const Rotation* rotations, int count, Matrix3x3* results)
+{
+	for (auto index = 0; index < count; index++)
+		results[index] = Matrix3x3::CreateTransform(translations[index], scales[index], rotations[index], { 0.0f, 0.0f });
+}
+
+void Pargon::BuildTransforms(const Vector3* translations, const Vector3* scales, const Quaternion* rotations, int count, Matrix4x4* results)
+{
+	auto index = 0;
+
+#if PARGON_MATH_SSE
+	auto one = _mm_set1_ps(1.0f);
+	auto lastColumn = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+
+	for (; index + 4 <= count; index += 4)
+	{
+		__m128 translationX, translationY, translationZ;
+		__m128 scaleX, scaleY, scaleZ;
+
+		Simd::LoadInterleaved3(&translations[index].X, translationX, translationY, translationZ);
+		Simd::LoadInterleaved3(&scales[index].X, scaleX, scaleY, scaleZ);
+
+		auto x = _mm_loadu_ps(&rotations[index + 0].X);
+		auto y = _mm_loadu_ps(&rotations[index + 1].X);
+		auto z = _mm_loadu_ps(&rotations[index + 2].X);
+		auto w = _mm_loadu_ps(&rotations[index + 3].X);
+
+		_MM_TRANSPOSE4_PS(x, y, z, w);
+
+		auto x2 = _mm_add_ps(x, x), y2 = _mm_add_ps(y, y), z2 = _mm_add_ps(z, z);
+		auto xx2 = _mm_mul_ps(x, x2), yy2 = _mm_mul_ps(y, y2), zz2 = _mm_mul_ps(z, z2);
+		auto xy2 = _mm_mul_ps(x, y2), yz2 = _mm_mul_ps(y, z2), zx2 = _mm_mul_ps(z, x2);
+		auto xw2 = _mm_mul_ps(w, x2), yw2 = _mm_mul_ps(w, y2), zw2 = _mm_mul_ps(w, z2);
+
+		__m128 rows[4][4] =
+		{
+			{ _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(one, yy2), zz2), scaleX), _mm_mul_ps(_mm_add_ps(xy2, zw2), scaleX), _mm_mul_ps(_mm_sub_ps(zx2, yw2), scaleX), _mm_setzero_ps() },
+			{ _mm_mul_ps(_mm_sub_ps(xy2, zw2), scaleY), _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(one, zz2), xx2), scaleY), _mm_mul_ps(_mm_add_ps(yz2, xw2), scaleY), _mm_setzero_ps() },
+			{ _mm_mul_ps(_mm_add_ps(zx2, yw2), scaleZ), _mm_mul_ps(_mm_sub_ps(yz2, xw2), scaleZ), _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(one, xx2), yy2), scaleZ), _mm_setzero_ps() },
+			{ translationX, translationY, translationZ, _mm_setzero_ps() }
+		};
+
+		for (auto row = 0; row < 4; row++)
+		{
+			_MM_TRANSPOSE4_PS(rows[row][0], rows[row][1], rows[row][2], rows[row][3]);
+
+			for (auto matrix = 0; matrix < 4; matrix++)
+				_mm_storeu_ps(results[index + matrix].Elements.begin() + row * 4, row == 3 ? _mm_or_ps(rows[row][matrix], lastColumn) : rows[row][matrix]);
+		}
+	}
+#endif
+
+	for (; index < count; index++)
+		results[index] = Matrix4x4::CreateTransform(translations[index], scales[index], rotations[index], { 0.0f, 0.0f, 0.0f });
+}
+
+void Pargon::DecomposeTransforms(const Matrix4x4* matrices, int count, Matrix4x4::Transform* results, TransformDecomposition decomposition)
+{
+#if PARGON_MATH_SSE
+	for (auto index = 0; index < count; index += Simd::Wide::Width)
+		DecomposeTransformBlock(matrices + index, std::min(count - index, Simd::Wide::Width), results + index, decomposition);
+#else
+	for (auto index = 0; index < count; index++)
+		results[index] = DecomposeTransform(matrices[index], decomposition);
+#endif
+}
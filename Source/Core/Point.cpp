@@ -1,11 +1,14 @@
 #include "Pargon/Math/Matrix.h"
 #include "Pargon/Math/Point.h"
+#include "Pargon/Math/Stream.h"
 #include "Pargon/Math/Vector.h"
 #include "Pargon/Serialization/BufferReader.h"
 #include "Pargon/Serialization/BufferWriter.h"
 #include "Pargon/Serialization/StringReader.h"
 #include "Pargon/Serialization/StringWriter.h"
+#include "Core/Simd.h"
 
+#include <algorithm>
 #include <cml/cml.h>
 
 using namespace Pargon;
@@ -113,3 +116,200 @@ void Point3::FromString(StringReader& reader, StringView format)
 	if (!reader.Parse(_point3Parse, X, Y, Z))
 		reader.ReportError("the string could not be read as a Point3 (expected three floating point numbers separated by whitespace and/or a comma)");
 }
+
+void Pargon::TransformPoints(const Point2* points, int count, const Matrix3x3& transform, Point2* results)
+{
+	auto index = 0;
+
+#if PARGON_MATH_SSE
+	auto& m = transform.Elements;
+
+	auto m00 = _mm_set1_ps(m.Item(0)), m01 = _mm_set1_ps(m.Item(1));
+	auto m10 = _mm_set1_ps(m.Item(3)), m11 = _mm_set1_ps(m.Item(4));
+	auto m20 = _mm_set1_ps(m.Item(6)), m21 = _mm_set1_ps(m.Item(7));
+
+	for (; index + 4 <= count; index += 4)
+	{
+		__m128 x, y;
+		Simd::LoadInterleaved2(&points[index].X, x, y);
+
+		auto resultX = _mm_add_ps(Simd::MultiplyAdd(y, m10, _mm_mul_ps(x, m00)), m20);
+		auto resultY = _mm_add_ps(Simd::MultiplyAdd(y, m11, _mm_mul_ps(x, m01)), m21);
+
+		Simd::StoreInterleaved2(&results[index].X, resultX, resultY);
+	}
+#endif
+
+	for (; index < count; index++)
+		results[index] = points[index] * transform;
+}
+
+void Pargon::TransformPoints(const Point3* points, int count, const Matrix4x4& transform, Point3* results)
+{
+	auto index = 0;
+
+#if PARGON_MATH_SSE
+	auto& m = transform.Elements;
+	auto affine = transform.IsAffine();
+
+	auto m00 = _mm_set1_ps(m.Item(0)), m01 = _mm_set1_ps(m.Item(1)), m02 = _mm_set1_ps(m.Item(2)), m03 = _mm_set1_ps(m.Item(3));
+	auto m10 = _mm_set1_ps(m.Item(4)), m11 = _mm_set1_ps(m.Item(5)), m12 = _mm_set1_ps(m.Item(6)), m13 = _mm_set1_ps(m.Item(7));
+	auto m20 = _mm_set1_ps(m.Item(8)), m21 = _mm_set1_ps(m.Item(9)), m22 = _mm_set1_ps(m.Item(10)), m23 = _mm_set1_ps(m.Item(11));
+	auto m30 = _mm_set1_ps(m.Item(12)), m31 = _mm_set1_ps(m.Item(13)), m32 = _mm_set1_ps(m.Item(14)), m33 = _mm_set1_ps(m.Item(15));
+
+	for (; index + 4 <= count; index += 4)
+	{
+		__m128 x, y, z;
+		Simd::LoadInterleaved3(&points[index].X, x, y, z);
+
+		auto resultX = _mm_add_ps(Simd::MultiplyAdd(z, m20, Simd::MultiplyAdd(y, m10, _mm_mul_ps(x, m00))), m30);
+		auto resultY = _mm_add_ps(Simd::MultiplyAdd(z, m21, Simd::MultiplyAdd(y, m11, _mm_mul_ps(x, m01))), m31);
+		auto resultZ = _mm_add_ps(Simd::MultiplyAdd(z, m22, Simd::MultiplyAdd(y, m12, _mm_mul_ps(x, m02))), m32);
+
+		if (!affine)
+		{
+			auto resultW = _mm_add_ps(Simd::MultiplyAdd(z, m23, Simd::MultiplyAdd(y, m13, _mm_mul_ps(x, m03))), m33);
+
+			resultX = _mm_div_ps(resultX, resultW);
+			resultY = _mm_div_ps(resultY, resultW);
+			resultZ = _mm_div_ps(resultZ, resultW);
+		}
+
+		Simd::StoreInterleaved3(&results[index].X, resultX, resultY, resultZ);
+	}
+#endif
+
+	for (; index < count; index++)
+		results[index] = points[index] * transform;
+}
+
+void Pargon::TransformPoints(const Point3Stream& points, const Matrix4x4& transform, Point3Stream& results)
+{
+	results.SetCount(points.Count());
+
+	auto& m = transform.Elements;
+	auto affine = transform.IsAffine();
+
+	auto m00 = Simd::Wide::Broadcast(m.Item(0)), m01 = Simd::Wide::Broadcast(m.Item(1)), m02 = Simd::Wide::Broadcast(m.Item(2)), m03 = Simd::Wide::Broadcast(m.Item(3));
+	auto m10 = Simd::Wide::Broadcast(m.Item(4)), m11 = Simd::Wide::Broadcast(m.Item(5)), m12 = Simd::Wide::Broadcast(m.Item(6)), m13 = Simd::Wide::Broadcast(m.Item(7));
+	auto m20 = Simd::Wide::Broadcast(m.Item(8)), m21 = Simd::Wide::Broadcast(m.Item(9)), m22 = Simd::Wide::Broadcast(m.Item(10)), m23 = Simd::Wide::Broadcast(m.Item(11));
+	auto m30 = Simd::Wide::Broadcast(m.Item(12)), m31 = Simd::Wide::Broadcast(m.Item(13)), m32 = Simd::Wide::Broadcast(m.Item(14)), m33 = Simd::Wide::Broadcast(m.Item(15));
+
+	for (auto index = 0; index < points.PaddedCount(); index += Simd::Wide::Width)
+	{
+		auto x = Simd::Wide::Load(points.GetX() + index);
+		auto y = Simd::Wide::Load(points.GetY() + index);
+		auto z = Simd::Wide::Load(points.GetZ() + index);
+
+		auto resultX = Simd::MultiplyAdd(z, m20, Simd::MultiplyAdd(y, m10, x * m00)) + m30;
+		auto resultY = Simd::MultiplyAdd(z, m21, Simd::MultiplyAdd(y, m11, x * m01)) + m31;
+		auto resultZ = Simd::MultiplyAdd(z, m22, Simd::MultiplyAdd(y, m12, x * m02)) + m32;
+
+		if (!affine)
+		{
+			auto resultW = Simd::MultiplyAdd(z, m23, Simd::MultiplyAdd(y, m13, x * m03)) + m33;
+
+			resultX = resultX / resultW;
+			resultY = resultY / resultW;
+			resultZ = resultZ / resultW;
+		}
+
+		resultX.Store(results.GetX() + index);
+		resultY.Store(results.GetY() + index);
+		resultZ.Store(results.GetZ() + index);
+	}
+}
+
+void Pargon::ProjectPoints(const Point3* points, int count, const Matrix4x4& projection, Point3* results, float* clipW, std::uint32_t* visibility)
+{
+	// Results are in normalized device coordinates. A point is visible when it lies inside the clip volume used by
+	// CreatePerspectiveProjection and CreateOrthographicProjection (-w <= x <= w, -w <= y <= w, 0 <= z <= w). The
+	// visibility bits are packed 32 points to a word so visibility must hold at least (count + 31) / 32 entries.
+
+	if (visibility)
+		std::fill(visibility, visibility + (count + 31) / 32, 0u);
+
+	auto& m = projection.Elements;
+
+#if PARGON_MATH_SSE
+	auto m00 = _mm_set1_ps(m.Item(0)), m01 = _mm_set1_ps(m.Item(1)), m02 = _mm_set1_ps(m.Item(2)), m03 = _mm_set1_ps(m.Item(3));
+	auto m10 = _mm_set1_ps(m.Item(4)), m11 = _mm_set1_ps(m.Item(5)), m12 = _mm_set1_ps(m.Item(6)), m13 = _mm_set1_ps(m.Item(7));
+	auto m20 = _mm_set1_ps(m.Item(8)), m21 = _mm_set1_ps(m.Item(9)), m22 = _mm_set1_ps(m.Item(10)), m23 = _mm_set1_ps(m.Item(11));
+	auto m30 = _mm_set1_ps(m.Item(12)), m31 = _mm_set1_ps(m.Item(13)), m32 = _mm_set1_ps(m.Item(14)), m33 = _mm_set1_ps(m.Item(15));
+
+	auto project = [&](const float* input, float* output, float* w) -> int
+	{
+		__m128 x, y, z;
+		Simd::LoadInterleaved3(input, x, y, z);
+
+		auto clipX = _mm_add_ps(Simd::MultiplyAdd(z, m20, Simd::MultiplyAdd(y, m10, _mm_mul_ps(x, m00))), m30);
+		auto clipY = _mm_add_ps(Simd::MultiplyAdd(z, m21, Simd::MultiplyAdd(y, m11, _mm_mul_ps(x, m01))), m31);
+		auto clipZ = _mm_add_ps(Simd::MultiplyAdd(z, m22, Simd::MultiplyAdd(y, m12, _mm_mul_ps(x, m02))), m32);
+		auto clipW = _mm_add_ps(Simd::MultiplyAdd(z, m23, Simd::MultiplyAdd(y, m13, _mm_mul_ps(x, m03))), m33);
+
+		auto estimate = _mm_rcp_ps(clipW);
+		auto reciprocal = _mm_mul_ps(estimate, _mm_sub_ps(_mm_set1_ps(2.0f), _mm_mul_ps(clipW, estimate)));
+
+		Simd::StoreInterleaved3(output, _mm_mul_ps(clipX, reciprocal), _mm_mul_ps(clipY, reciprocal), _mm_mul_ps(clipZ, reciprocal));
+		_mm_storeu_ps(w, clipW);
+
+		auto negativeW = _mm_sub_ps(_mm_setzero_ps(), clipW);
+		auto inside = _mm_and_ps(_mm_cmple_ps(negativeW, clipX), _mm_cmple_ps(clipX, clipW));
+		inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmple_ps(negativeW, clipY), _mm_cmple_ps(clipY, clipW)));
+		inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmple_ps(_mm_setzero_ps(), clipZ), _mm_cmple_ps(clipZ, clipW)));
+
+		return _mm_movemask_ps(inside);
+	};
+
+	auto index = 0;
+
+	for (; index + 4 <= count; index += 4)
+	{
+		float w[4];
+		auto mask = project(&points[index].X, &results[index].X, clipW ? clipW + index : w);
+
+		if (visibility)
+			visibility[index / 32] |= static_cast<std::uint32_t>(mask) << (index % 32);
+	}
+
+	if (index < count)
+	{
+		auto remaining = count - index;
+
+		float input[12] = {};
+		float output[12];
+		float w[4];
+
+		std::copy(&points[index].X, &points[index].X + remaining * 3, input);
+
+		auto mask = project(input, output, w) & ((1 << remaining) - 1);
+
+		std::copy(output, output + remaining * 3, &results[index].X);
+
+		if (clipW)
+			std::copy(w, w + remaining, clipW + index);
+
+		if (visibility)
+			visibility[index / 32] |= static_cast<std::uint32_t>(mask) << (index % 32);
+	}
+#else
+	for (auto index = 0; index < count; index++)
+	{
+		auto point = points[index];
+
+		auto x = point.X * m.Item(0) + point.Y * m.Item(4) + point.Z * m.Item(8) + m.Item(12);
+		auto y = point.X * m.Item(1) + point.Y * m.Item(5) + point.Z * m.Item(9) + m.Item(13);
+		auto z = point.X * m.Item(2) + point.Y * m.Item(6) + point.Z * m.Item(10) + m.Item(14);
+		auto w = point.X * m.Item(3) + point.Y * m.Item(7) + point.Z * m.Item(11) + m.Item(15);
+		auto reciprocal = 1.0f / w;
+
+		results[index] = { x * reciprocal, y * reciprocal, z * reciprocal };
+
+		if (clipW)
+			clipW[index] = w;
+
+		if (visibility && -w <= x && x <= w && -w <= y && y <= w && 0.0f <= z && z <= w)
+			visibility[index / 32] |= 1u << (index % 32);
+	}
+#endif
+}
@@ -3,16 +3,189 @@
 #include "Pargon/Math/Matrix.h"
 #include "Pargon/Math/Quaternion.h"
 #include "Pargon/Math/Rotation.h"
+#include "Pargon/Math/Stream.h"
 #include "Pargon/Math/Vector.h"
 #include "Pargon/Serialization/BufferReader.h"
 #include "Pargon/Serialization/BufferWriter.h"
 #include "Pargon/Serialization/StringReader.h"
 #include "Pargon/Serialization/StringWriter.h"
+#include "Core/Simd.h"
 
+#include <algorithm>
+#include <cassert>
+#include <cmath>
 #include <cml/cml.h>
 
 using namespace Pargon;
 
+namespace
+{
+	constexpr auto _quaternionBlock = Simd::Wide::Width * 4;
+
+	void LoadQuaternions(const float* data, Simd::Wide& x, Simd::Wide& y, Simd::Wide& z, Simd::Wide& w)
+	{
+		x = Simd::Wide::LoadUnaligned(data + Simd::Wide::Width * 0);
+		y = Simd::Wide::LoadUnaligned(data + Simd::Wide::Width * 1);
+		z = Simd::Wide::LoadUnaligned(data + Simd::Wide::Width * 2);
+		w = Simd::Wide::LoadUnaligned(data + Simd::Wide::Width * 3);
+
+		Simd::Transpose4(x, y, z, w);
+	}
+
+	void StoreQuaternions(float* data, Simd::Wide x, Simd::Wide y, Simd::Wide z, Simd::Wide w)
+	{
+		Simd::Transpose4(x, y, z, w);
+
+		x.StoreUnaligned(data + Simd::Wide::Width * 0);
+		y.StoreUnaligned(data + Simd::Wide::Width * 1);
+		z.StoreUnaligned(data + Simd::Wide::Width * 2);
+		w.StoreUnaligned(data + Simd::Wide::Width * 3);
+	}
+
+	auto LoadTimes(const float* times) -> Simd::Wide
+	{
+#if PARGON_MATH_AVX
+		auto low = _mm_loadu_ps(times + 0);
+		auto high = _mm_loadu_ps(times + 4);
+
+		return { _mm256_set_m128(_mm_shuffle_ps(low, high, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(low, high, _MM_SHUFFLE(2, 0, 2, 0))) };
+#else
+		return Simd::Wide::LoadUnaligned(times);
+#endif
+	}
+
+	void NormalizeLanes(Simd::Wide& x, Simd::Wide& y, Simd::Wide& z, Simd::Wide& w)
+	{
+		auto scale = Simd::Wide::Broadcast(1.0f) / Simd::SquareRoot(x * x + y * y + z * z + w * w);
+
+		x = x * scale;
+		y = y * scale;
+		z = z * scale;
+		w = w * scale;
+	}
+
+	void MultiplyQuaternionBlock(const float* left, const float* right, float* result, bool normalize)
+	{
+		Simd::Wide leftX, leftY, leftZ, leftW;
+		Simd::Wide rightX, rightY, rightZ, rightW;
+
+		LoadQuaternions(left, leftX, leftY, leftZ, leftW);
+		LoadQuaternions(right, rightX, rightY, rightZ, rightW);
+
+		auto x = (leftW * rightX + rightW * leftX) - (leftY * rightZ - leftZ * rightY);
+		auto y = (leftW * rightY + rightW * leftY) - (leftZ * rightX - leftX * rightZ);
+		auto z = (leftW * rightZ + rightW * leftZ) - (leftX * rightY - leftY * rightX);
+		auto w = leftW * rightW - leftX * rightX - leftY * rightY - leftZ * rightZ;
+
+		if (normalize)
+			NormalizeLanes(x, y, z, w);
+
+		StoreQuaternions(result, x, y, z, w);
+	}
+
+	constexpr float _slerpTolerance = 0.0001f;
+	constexpr float _slerpOnePlusMu = 1.90110745351730037f;
+
+	constexpr float _slerpU[8] = { 1.0f / (1 * 3), 1.0f / (2 * 5), 1.0f / (3 * 7), 1.0f / (4 * 9), 1.0f / (5 * 11), 1.0f / (6 * 13), 1.0f / (7 * 15), _slerpOnePlusMu / (8 * 17) };
+	constexpr float _slerpV[8] = { 1.0f / 3, 2.0f / 5, 3.0f / 7, 4.0f / 9, 5.0f / 11, 6.0f / 13, 7.0f / 15, _slerpOnePlusMu * 8 / 17 };
+
+	auto ApproximateSlerpWeight(Simd::Wide time, Simd::Wide cosineMinusOne) -> Simd::Wide
+	{
+		auto one = Simd::Wide::Broadcast(1.0f);
+		auto timeSquared = time * time;
+		auto weight = one;
+
+		for (auto i = 7; i >= 0; i--)
+		{
+			auto term = (Simd::Wide::Broadcast(_slerpU[i]) * timeSquared - Simd::Wide::Broadcast(_slerpV[i])) * cosineMinusOne;
+			weight = Simd::MultiplyAdd(term, weight, one);
+		}
+
+		return time * weight;
+	}
+
+	void InterpolateLanes(Simd::Wide& x, Simd::Wide& y, Simd::Wide& z, Simd::Wide& w, Simd::Wide toX, Simd::Wide toY, Simd::Wide toZ, Simd::Wide toW, Simd::Wide time, QuaternionInterpolation mode)
+	{
+		auto one = Simd::Wide::Broadcast(1.0f);
+		auto cosine = x * toX + y * toY + z * toZ + w * toW;
+		auto sign = cosine & Simd::SignMask();
+
+		toX = toX ^ sign;
+		toY = toY ^ sign;
+		toZ = toZ ^ sign;
+		toW = toW ^ sign;
+		cosine = Simd::AbsoluteValue(cosine);
+
+		auto fromWeight = one - time;
+		auto toWeight = time;
+		auto normalize = Simd::Wide::Broadcast(Simd::FromBits(0xFFFFFFFFu));
+
+		if (mode == QuaternionInterpolation::Slerp)
+		{
+			float cosines[Simd::Wide::Width];
+			float times[Simd::Wide::Width];
+			float fromWeights[Simd::Wide::Width];
+			float toWeights[Simd::Wide::Width];
+			float sines[Simd::Wide::Width];
+
+			cosine.StoreUnaligned(cosines);
+			time.StoreUnaligned(times);
+
+			for (auto lane = 0; lane < Simd::Wide::Width; lane++)
+			{
+				auto omega = std::acos(std::min(cosines[lane], 1.0f));
+				sines[lane] = std::sin(omega);
+				fromWeights[lane] = std::sin((1.0f - times[lane]) * omega) / sines[lane];
+				toWeights[lane] = std::sin(times[lane] * omega) / sines[lane];
+			}
+
+			normalize = Simd::LessThan(Simd::Wide::LoadUnaligned(sines), Simd::Wide::Broadcast(_slerpTolerance));
+			fromWeight = Simd::Select(normalize, fromWeight, Simd::Wide::LoadUnaligned(fromWeights));
+			toWeight = Simd::Select(normalize, toWeight, Simd::Wide::LoadUnaligned(toWeights));
+		}
+		else if (mode == QuaternionInterpolation::ApproximateSlerp)
+		{
+			auto cosineMinusOne = cosine - one;
+
+			fromWeight = ApproximateSlerpWeight(fromWeight, cosineMinusOne);
+			toWeight = ApproximateSlerpWeight(toWeight, cosineMinusOne);
+			normalize = Simd::Wide::Broadcast(0.0f);
+		}
+
+		x = Simd::MultiplyAdd(toWeight, toX, fromWeight * x);
+		y = Simd::MultiplyAdd(toWeight, toY, fromWeight * y);
+		z = Simd::MultiplyAdd(toWeight, toZ, fromWeight * z);
+		w = Simd::MultiplyAdd(toWeight, toW, fromWeight * w);
+
+		auto scale = Simd::Select(normalize, one / Simd::SquareRoot(x * x + y * y + z * z + w * w), one);
+
+		x = x * scale;
+		y = y * scale;
+		z = z * scale;
+		w = w * scale;
+	}
+
+	void InterpolateQuaternionBlock(const float* from, const float* to, const float* times, float* result, QuaternionInterpolation mode)
+	{
+		Simd::Wide x, y, z, w;
+		Simd::Wide toX, toY, toZ, toW;
+
+		LoadQuaternions(from, x, y, z, w);
+		LoadQuaternions(to, toX, toY, toZ, toW);
+		InterpolateLanes(x, y, z, w, toX, toY, toZ, toW, LoadTimes(times), mode);
+		StoreQuaternions(result, x, y, z, w);
+	}
+
+	void NormalizeQuaternionBlock(float* quaternions)
+	{
+		Simd::Wide x, y, z, w;
+
+		LoadQuaternions(quaternions, x, y, z, w);
+		NormalizeLanes(x, y, z, w);
+		StoreQuaternions(quaternions, x, y, z, w);
+	}
+}
+
 auto Quaternion::CreateYaw(Rotation angle) -> Quaternion
 {
 	Quaternion quaternion;
@@ -249,3 +422,100 @@ void Quaternion::FromString(StringReader& reader, StringView format)
 			reader.ReportError("the string could not be read as a Quaternion (expected four floating point numbers separated by a space");
 	}
 }
+
+void Pargon::MultiplyQuaternions(const Quaternion* left, const Quaternion* right, int count, Quaternion* results, bool normalize)
+{
+	auto index = 0;
+
+	for (; index + Simd::Wide::Width <= count; index += Simd::Wide::Width)
+		MultiplyQuaternionBlock(&left[index].X, &right[index].X, &results[index].X, normalize);
+
+	if (index < count)
+	{
+		float leftBlock[_quaternionBlock] = {};
+		float rightBlock[_quaternionBlock] = {};
+		float resultBlock[_quaternionBlock];
+
+		auto remaining = (count - index) * 4;
+
+		std::copy(&left[index].X, &left[index].X + remaining, leftBlock);
+		std::copy(&right[index].X, &right[index].X + remaining, rightBlock);
+
+		MultiplyQuaternionBlock(leftBlock, rightBlock, resultBlock, normalize);
+
+		std::copy(resultBlock, resultBlock + remaining, &results[index].X);
+	}
+}
+
+void Pargon::NormalizeQuaternions(Quaternion* quaternions, int count)
+{
+	auto index = 0;
+
+	for (; index + Simd::Wide::Width <= count; index += Simd::Wide::Width)
+		NormalizeQuaternionBlock(&quaternions[index].X);
+
+	if (index < count)
+	{
+		float block[_quaternionBlock] = {};
+
+		auto remaining = (count - index) * 4;
+
+		std::copy(&quaternions[index].X, &quaternions[index].X + remaining, block);
+		NormalizeQuaternionBlock(block);
+		std::copy(block, block + remaining, &quaternions[index].X);
+	}
+}
+
+void Pargon::InterpolateQuaternions(const Quaternion* from, const Quaternion* to, const float* times, int count, Quaternion* results, QuaternionInterpolation mode)
+{
+	auto index = 0;
+
+	for (; index + Simd::Wide::Width <= count; index += Simd::Wide::Width)
+		InterpolateQuaternionBlock(&from[index].X, &to[index].X, times + index, &results[index].X, mode);
+
+	if (index < count)
+	{
+		float fromBlock[_quaternionBlock] = {};
+		float toBlock[_quaternionBlock] = {};
+		float timeBlock[Simd::Wide::Width] = {};
+		float resultBlock[_quaternionBlock];
+
+		auto remaining = count - index;
+
+		for (auto i = remaining; i < Simd::Wide::Width; i++)
+		{
+			fromBlock[i * 4 + 3] = 1.0f;
+			toBlock[i * 4 + 3] = 1.0f;
+		}
+
+		std::copy(&from[index].X, &from[index].X + remaining * 4, fromBlock);
+		std::copy(&to[index].X, &to[index].X + remaining * 4, toBlock);
+		std::copy(times + index, times + count, timeBlock);
+
+		InterpolateQuaternionBlock(fromBlock, toBlock, timeBlock, resultBlock, mode);
+
+		std::copy(resultBlock, resultBlock + remaining * 4, &results[index].X);
+	}
+}
+
+void Pargon::InterpolateQuaternions(const QuaternionStream& from, const QuaternionStream& to, const FloatStream& times, QuaternionStream& results, QuaternionInterpolation mode)
+{
+	assert(to.Count() == from.Count() && times.Count() == from.Count());
+
+	results.SetCount(from.Count());
+
+	for (auto index = 0; index < from.PaddedCount(); index += Simd::Wide::Width)
+	{
+		auto x = Simd::Wide::Load(from.GetX() + index);
+		auto y = Simd::Wide::Load(from.GetY() + index);
+		auto z = Simd::Wide::Load(from.GetZ() + index);
+		auto w = Simd::Wide::Load(from.GetW() + index);
+
+		InterpolateLanes(x, y, z, w, Simd::Wide::Load(to.GetX() + index), Simd::Wide::Load(to.GetY() + index), Simd::Wide::Load(to.GetZ() + index), Simd::Wide::Load(to.GetW() + index), Simd::Wide::Load(times.Data() + index), mode);
+
+		x.Store(results.GetX() + index);
+		y.Store(results.GetY() + index);
+		z.Store(results.GetZ() + index);
+		w.Store(results.GetW() + index);
+	}
+}
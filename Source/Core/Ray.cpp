@@ -0,0 +1,230 @@
+#include "Pargon/Math/Ray.h"
+#include "Pargon/Math/Bounds.h"
+#include "Pargon/Math/Matrix.h"
+#include "Pargon/Math/Stream.h"
+#include "Pargon/Serialization/BufferReader.h"
+#include "Pargon/Serialization/BufferWriter.h"
+#include "Pargon/Serialization/StringReader.h"
+#include "Pargon/Serialization/StringWriter.h"
+#include "Core/Simd.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cml/cml.h>
+
+using namespace Pargon;
+
+namespace
+{
+	struct WideVector
+	{
+		Simd::Wide X;
+		Simd::Wide Y;
+		Simd::Wide Z;
+	};
+
+	auto Broadcast(float x, float y, float z) -> WideVector
+	{
+		return { Simd::Wide::Broadcast(x), Simd::Wide::Broadcast(y), Simd::Wide::Broadcast(z) };
+	}
+
+	auto Load(const float* x, const float* y, const float* z, int index) -> WideVector
+	{
+		return { Simd::Wide::Load(x + index), Simd::Wide::Load(y + index), Simd::Wide::Load(z + index) };
+	}
+
+	auto Subtract(const WideVector& left, const WideVector& right) -> WideVector
+	{
+		return { left.X - right.X, left.Y - right.Y, left.Z - right.Z };
+	}
+
+	auto Dot(const WideVector& left, const WideVector& right) -> Simd::Wide
+	{
+		return Simd::MultiplyAdd(left.Z, right.Z, Simd::MultiplyAdd(left.Y, right.Y, left.X * right.X));
+	}
+
+	auto Cross(const WideVector& left, const WideVector& right) -> WideVector
+	{
+		return
+		{
+			left.Y * right.Z - left.Z * right.Y,
+			left.Z * right.X - left.X * right.Z,
+			left.X * right.Y - left.Y * right.X
+		};
+	}
+
+	template<typename Test>
+	void IntersectBlocks(const Point3Stream& origins, const Vector3Stream& directions, FloatStream& distances, std::uint32_t* hits, Test test)
+	{
+		assert(origins.Count() == directions.Count());
+		assert(origins.Count() == distances.Count());
+
+		auto count = origins.Count();
+		std::fill(hits, hits + (count + 31) / 32, 0u);
+
+		for (auto index = 0; index < count; index += Simd::Wide::Width)
+		{
+			auto origin = Load(origins.GetX(), origins.GetY(), origins.GetZ(), index);
+			auto direction = Load(directions.GetX(), directions.GetY(), directions.GetZ(), index);
+			auto distance = Simd::Wide::Load(distances.Data() + index);
+			auto hit = test(origin, direction, distance);
+
+			distance.Store(distances.Data() + index);
+
+			auto mask = static_cast<std::uint32_t>(Simd::MoveMask(hit));
+			auto remaining = count - index;
+
+			if (remaining < Simd::Wide::Width)
+				mask &= (1u << remaining) - 1;
+
+			hits[index / 32] |= mask << (index % 32);
+		}
+	}
+}
+
+auto Ray3::CreatePickRay(Point2 position, Point2 viewportPosition, Vector2 viewportSize, const Matrix4x4& view, const Matrix4x4& projection) -> Ray3
+{
+	cml::matrix<float, cml::external<4, 4>, cml::row_basis, cml::row_major> v(const_cast<float*>(view.Elements.begin()));
+	cml::matrix<float, cml::external<4, 4>, cml::row_basis, cml::row_major> p(const_cast<float*>(projection.Elements.begin()));
+	cml::matrix<float, cml::fixed<4, 4>, cml::row_basis, cml::row_major> viewport;
+	cml::matrix_viewport(viewport, viewportPosition.X, viewportPosition.X + viewportSize.X, viewportPosition.Y, viewportPosition.Y + viewportSize.Y, cml::z_clip_zero);
+
+	cml::vector<float, cml::fixed<3>> origin, direction;
+	cml::make_pick_ray(position.X, position.Y, v, p, viewport, origin, direction);
+
+	return { { origin[0], origin[1], origin[2] }, { direction[0], direction[1], direction[2] } };
+}
+
+auto Ray3::IntersectBox(const Aabb3& bounds, float& distance) const -> bool
+{
+	auto x1 = (bounds.Minimum.X - Origin.X) / Direction.X, x2 = (bounds.Maximum.X - Origin.X) / Direction.X;
+	auto y1 = (bounds.Minimum.Y - Origin.Y) / Direction.Y, y2 = (bounds.Maximum.Y - Origin.Y) / Direction.Y;
+	auto z1 = (bounds.Minimum.Z - Origin.Z) / Direction.Z, z2 = (bounds.Maximum.Z - Origin.Z) / Direction.Z;
+
+	auto near = std::max(std::max(std::min(x1, x2), std::min(y1, y2)), std::max(std::min(z1, z2), 0.0f));
+	auto far = std::min(std::min(std::max(x1, x2), std::max(y1, y2)), std::min(std::max(z1, z2), distance));
+
+	if (!(near <= far))
+		return false;
+
+	distance = near;
+	return true;
+}
+
+auto Ray3::IntersectTriangle(Point3 a, Point3 b, Point3 c, float& distance) const -> bool
+{
+	// Moller-Trumbore. A ray parallel to the triangle gives an infinite or undefined reciprocal which fails every
+	// comparison below, so it needs no separate check.
+
+	auto edge1 = b - a;
+	auto edge2 = c - a;
+	auto p = Direction.GetCrossProduct(edge2);
+	auto inverse = 1.0f / edge1.GetDotProduct(p);
+	auto s = Origin - a;
+	auto u = s.GetDotProduct(p) * inverse;
+
+	if (!(u >= 0.0f && u <= 1.0f))
+		return false;
+
+	auto q = s.GetCrossProduct(edge1);
+	auto v = Direction.GetDotProduct(q) * inverse;
+
+	if (!(v >= 0.0f && u + v <= 1.0f))
+		return false;
+
+	auto t = edge2.GetDotProduct(q) * inverse;
+
+	if (!(t >= 0.0f && t <= distance))
+		return false;
+
+	distance = t;
+	return true;
+}
+
+void Ray3::Transform(const Matrix4x4& transform)
+{
+	Origin *= transform;
+	Direction *= transform;
+}
+
+auto Ray3::Transformed(const Matrix4x4& transform) const -> Ray3
+{
+	auto ray = *this;
+	ray.Transform(transform);
+	return ray;
+}
+
+void Ray3::ToBuffer(BufferWriter& writer) const
+{
+	Origin.ToBuffer(writer);
+	Direction.ToBuffer(writer);
+}
+
+void Ray3::FromBuffer(BufferReader& reader)
+{
+	Origin.FromBuffer(reader);
+	Direction.FromBuffer(reader);
+}
+
+void Ray3::ToString(StringWriter& writer, StringView format) const
+{
+	writer.Format("{} {} {} {} {} {}", Origin.X, Origin.Y, Origin.Z, Direction.X, Direction.Y, Direction.Z);
+}
+
+void Ray3::FromString(StringReader& reader, StringView format)
+{
+	if (!reader.Parse("{} {} {} {} {} {}", Origin.X, Origin.Y, Origin.Z, Direction.X, Direction.Y, Direction.Z))
+		reader.ReportError("the string could not be read as a Ray3 (expected six floating point numbers separated by a space");
+}
+
+void Pargon::IntersectRays(const Point3Stream& origins, const Vector3Stream& directions, const Aabb3& bounds, FloatStream& distances, std::uint32_t* hits)
+{
+	auto minimum = Broadcast(bounds.Minimum.X, bounds.Minimum.Y, bounds.Minimum.Z);
+	auto maximum = Broadcast(bounds.Maximum.X, bounds.Maximum.Y, bounds.Maximum.Z);
+	auto zero = Simd::Wide::Broadcast(0.0f);
+
+	IntersectBlocks(origins, directions, distances, hits, [&](const WideVector& origin, const WideVector& direction, Simd::Wide& distance)
+	{
+		auto one = Simd::Wide::Broadcast(1.0f);
+		auto inverse = WideVector{ one / direction.X, one / direction.Y, one / direction.Z };
+		auto low = Subtract(minimum, origin);
+		auto high = Subtract(maximum, origin);
+
+		auto x1 = low.X * inverse.X, x2 = high.X * inverse.X;
+		auto y1 = low.Y * inverse.Y, y2 = high.Y * inverse.Y;
+		auto z1 = low.Z * inverse.Z, z2 = high.Z * inverse.Z;
+
+		auto near = Simd::Maximum(Simd::Maximum(Simd::Minimum(x1, x2), Simd::Minimum(y1, y2)), Simd::Maximum(Simd::Minimum(z1, z2), zero));
+		auto far = Simd::Minimum(Simd::Minimum(Simd::Maximum(x1, x2), Simd::Maximum(y1, y2)), Simd::Minimum(Simd::Maximum(z1, z2), distance));
+		auto hit = Simd::LessThanOrEqual(near, far);
+
+		distance = Simd::Select(hit, near, distance);
+		return hit;
+	});
+}
+
+void Pargon::IntersectRays(const Point3Stream& origins, const Vector3Stream& directions, Point3 a, Point3 b, Point3 c, FloatStream& distances, std::uint32_t* hits)
+{
+	auto vertex = Broadcast(a.X, a.Y, a.Z);
+	auto edge1 = Broadcast(b.X - a.X, b.Y - a.Y, b.Z - a.Z);
+	auto edge2 = Broadcast(c.X - a.X, c.Y - a.Y, c.Z - a.Z);
+	auto zero = Simd::Wide::Broadcast(0.0f);
+	auto one = Simd::Wide::Broadcast(1.0f);
+
+	IntersectBlocks(origins, directions, distances, hits, [&](const WideVector& origin, const WideVector& direction, Simd::Wide& distance)
+	{
+		auto p = Cross(direction, edge2);
+		auto inverse = one / Dot(edge1, p);
+		auto s = Subtract(origin, vertex);
+		auto q = Cross(s, edge1);
+		auto u = Dot(s, p) * inverse;
+		auto v = Dot(direction, q) * inverse;
+		auto t = Dot(edge2, q) * inverse;
+
+		auto inside = Simd::GreaterThanOrEqual(u, zero) & Simd::GreaterThanOrEqual(v, zero) & Simd::LessThanOrEqual(u + v, one);
+		auto hit = inside & Simd::GreaterThanOrEqual(t, zero) & Simd::LessThanOrEqual(t, distance);
+
+		distance = Simd::Select(hit, t, distance);
+		return hit;
+	});
+}
@@ -0,0 +1,557 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define PARGON_MATH_SSE 1
+	#include <immintrin.h>
+#else
+	#define PARGON_MATH_SSE 0
+#endif
+
+#if PARGON_MATH_SSE && defined(__AVX__)
+	#define PARGON_MATH_AVX 1
+#else
+	#define PARGON_MATH_AVX 0
+#endif
+
+#if PARGON_MATH_SSE && (defined(__FMA__) || (defined(_MSC_VER) && defined(__AVX2__)))
+	#define PARGON_MATH_FMA 1
+#else
+	#define PARGON_MATH_FMA 0
+#endif
+
+#if PARGON_MATH_SSE
+
+namespace Pargon::Simd
+{
+	inline auto MultiplyAdd(__m128 left, __m128 right, __m128 addend) -> __m128
+	{
+	#if PARGON_MATH_FMA
+		return _mm_fmadd_ps(left, right, addend);
+	#else
+		return _mm_add_ps(_mm_mul_ps(left, right), addend);
+	#endif
+	}
+
+	template<int Index>
+	inline auto Splat(__m128 value) -> __m128
+	{
+		return _mm_shuffle_ps(value, value, _MM_SHUFFLE(Index, Index, Index, Index));
+	}
+
+	template<int X, int Y, int Z, int W>
+	inline auto Swizzle(__m128 value) -> __m128
+	{
+		return _mm_shuffle_ps(value, value, _MM_SHUFFLE(W, Z, Y, X));
+	}
+
+	template<int X, int Y, int Z, int W>
+	inline auto Shuffle(__m128 left, __m128 right) -> __m128
+	{
+		return _mm_shuffle_ps(left, right, _MM_SHUFFLE(W, Z, Y, X));
+	}
+
+	inline auto Dot3(__m128 left, __m128 right) -> __m128
+	{
+		auto product = _mm_mul_ps(left, right);
+		return _mm_add_ps(_mm_add_ps(Splat<0>(product), Splat<1>(product)), Splat<2>(product));
+	}
+
+	inline auto Cross(__m128 left, __m128 right) -> __m128
+	{
+		auto first = _mm_mul_ps(Swizzle<1, 2, 0, 3>(left), Swizzle<2, 0, 1, 3>(right));
+		auto second = _mm_mul_ps(Swizzle<2, 0, 1, 3>(left), Swizzle<1, 2, 0, 3>(right));
+		return _mm_sub_ps(first, second);
+	}
+
+	inline void LoadInterleaved2(const float* data, __m128& x, __m128& y)
+	{
+		auto first = _mm_loadu_ps(data + 0);
+		auto second = _mm_loadu_ps(data + 4);
+
+		x = Shuffle<0, 2, 0, 2>(first, second);
+		y = Shuffle<1, 3, 1, 3>(first, second);
+	}
+
+	inline void StoreInterleaved2(float* data, __m128 x, __m128 y)
+	{
+		_mm_storeu_ps(data + 0, _mm_unpacklo_ps(x, y));
+		_mm_storeu_ps(data + 4, _mm_unpackhi_ps(x, y));
+	}
+
+	inline void LoadInterleaved3(const float* data, __m128& x, __m128& y, __m128& z)
+	{
+		auto first = _mm_loadu_ps(data + 0);
+		auto second = _mm_loadu_ps(data + 4);
+		auto third = _mm_loadu_ps(data + 8);
+
+		x = Shuffle<0, 3, 0, 2>(first, Shuffle<2, 2, 1, 1>(second, third));
+		y = Shuffle<0, 2, 0, 2>(Shuffle<1, 1, 0, 0>(first, second), Shuffle<3, 3, 2, 2>(second, third));
+		z = Shuffle<0, 2, 0, 3>(Shuffle<2, 2, 1, 1>(first, second), third);
+	}
+
+	inline void StoreInterleaved3(float* data, __m128 x, __m128 y, __m128 z)
+	{
+		auto low = _mm_unpacklo_ps(x, y);
+		auto high = _mm_unpackhi_ps(x, y);
+
+		_mm_storeu_ps(data + 0, Shuffle<0, 1, 0, 2>(low, Shuffle<0, 0, 1, 1>(z, x)));
+		_mm_storeu_ps(data + 4, Shuffle<0, 2, 0, 1>(Shuffle<1, 1, 1, 1>(y, z), high));
+		_mm_storeu_ps(data + 8, Shuffle<0, 2, 0, 2>(Shuffle<2, 2, 3, 3>(z, x), Shuffle<3, 3, 3, 3>(y, z)));
+	}
+
+	inline auto MultiplyRow(__m128 row, __m128 right0, __m128 right1, __m128 right2, __m128 right3) -> __m128
+	{
+		auto result = _mm_mul_ps(Splat<0>(row), right0);
+		result = MultiplyAdd(Splat<1>(row), right1, result);
+		result = MultiplyAdd(Splat<2>(row), right2, result);
+		result = MultiplyAdd(Splat<3>(row), right3, result);
+		return result;
+	}
+
+#if PARGON_MATH_AVX
+	inline auto MultiplyAdd(__m256 left, __m256 right, __m256 addend) -> __m256
+	{
+	#if PARGON_MATH_FMA
+		return _mm256_fmadd_ps(left, right, addend);
+	#else
+		return _mm256_add_ps(_mm256_mul_ps(left, right), addend);
+	#endif
+	}
+
+	template<int Index>
+	inline auto Splat(__m256 value) -> __m256
+	{
+		return _mm256_shuffle_ps(value, value, _MM_SHUFFLE(Index, Index, Index, Index));
+	}
+
+	inline auto MultiplyRows(__m256 rows, __m256 right0, __m256 right1, __m256 right2, __m256 right3) -> __m256
+	{
+		auto result = _mm256_mul_ps(Splat<0>(rows), right0);
+		result = MultiplyAdd(Splat<1>(rows), right1, result);
+		result = MultiplyAdd(Splat<2>(rows), right2, result);
+		result = MultiplyAdd(Splat<3>(rows), right3, result);
+		return result;
+	}
+#endif
+}
+
+#endif
+
+namespace Pargon::Simd
+{
+	struct Wide
+	{
+	#if PARGON_MATH_AVX
+		using Register = __m256;
+		static constexpr int Width = 8;
+	#elif PARGON_MATH_SSE
+		using Register = __m128;
+		static constexpr int Width = 4;
+	#else
+		using Register = float;
+		static constexpr int Width = 1;
+	#endif
+
+		Register Value;
+
+		static auto Load(const float* data) -> Wide;
+		static auto LoadUnaligned(const float* data) -> Wide;
+		static auto Broadcast(float value) -> Wide;
+
+		void Store(float* data) const;
+		void StoreUnaligned(float* data) const;
+	};
+
+	inline auto Wide::Load(const float* data) -> Wide
+	{
+	#if PARGON_MATH_AVX
+		return { _mm256_load_ps(data) };
+	#elif PARGON_MATH_SSE
+		return { _mm_load_ps(data) };
+	#else
+		return { *data };
+	#endif
+	}
+
+	inline auto Wide::LoadUnaligned(const float* data) -> Wide
+	{
+	#if PARGON_MATH_AVX
+		return { _mm256_loadu_ps(data) };
+	#elif PARGON_MATH_SSE
+		return { _mm_loadu_ps(data) };
+	#else
+		return { *data };
+	#endif
+	}
+
+	inline auto Wide::Broadcast(float value) -> Wide
+	{
+	#if PARGON_MATH_AVX
+		return { _mm256_set1_ps(value) };
+	#elif PARGON_MATH_SSE
+		return { _mm_set1_ps(value) };
+	#else
+		return { value };
+	#endif
+	}
+
+	inline void Wide::Store(float* data) const
+	{
+	#if PARGON_MATH_AVX
+		_mm256_store_ps(data, Value);
+	#elif PARGON_MATH_SSE
+		_mm_store_ps(data, Value);
+	#else
+		*data = Value;
+	#endif
+	}
+
+	inline void Wide::StoreUnaligned(float* data) const
+	{
+	#if PARGON_MATH_AVX
+		_mm256_storeu_ps(data, Value);
+	#elif PARGON_MATH_SSE
+		_mm_storeu_ps(data, Value);
+	#else
+		*data = Value;
+	#endif
+	}
+
+	inline auto operator+(Wide left, Wide right) -> Wide
+	{
+	#if PARGON_MATH_AVX
+		return { _mm256_add_ps(left.Value, right.Value) };
+	#elif PARGON_MATH_SSE
+		return { _mm_add_ps(left.Value, right.Value) };
+	#else
+		return { left.Value + right.Value };
+	#endif
+	}
+
+	inline auto operator-(Wide left, Wide right) -> Wide
+	{
+	#if PARGON_MATH_AVX
+		return { _mm256_sub_ps(left.Value, right.Value) };
+	#elif PARGON_MATH_SSE
+		return { _mm_sub_ps(left.Value, right.Value) };
+	#else
+		return { left.Value - right.Value };
+	#endif
+	}
+
+	inline auto operator*(Wide left, Wide right) -> Wide
+	{
+	#if PARGON_MATH_AVX
+		return { _mm256_mul_ps(left.Value, right.Value) };
+	#elif PARGON_MATH_SSE
+		return { _mm_mul_ps(left.Value, right.Value) };
+	#else
+		return { left.Value * right.Value };
+	#endif
+	}
+
+	inline auto operator/(Wide left, Wide right) -> Wide
+	{
+	#if PARGON_MATH_AVX
+		return { _mm256_div_ps(left.Value, right.Value) };
+	#elif PARGON_MATH_SSE
+		return { _mm_div_ps(left.Value, right.Value) };
+	#else
+		return { left.Value / right.Value };
+	#endif
+	}
+
+	inline auto MultiplyAdd(Wide left, Wide right, Wide addend) -> Wide
+	{
+	#if PARGON_MATH_SSE
+		return { MultiplyAdd(left.Value, right.Value, addend.Value) };
+	#else
+		return { left.Value * right.Value + addend.Value };
+	#endif
+	}
+
+	inline auto SquareRoot(Wide value) -> Wide
+	{
+	#if PARGON_MATH_AVX
+		return { _mm256_sqrt_ps(value.Value) };
+	#elif PARGON_MATH_SSE
+		return { _mm_sqrt_ps(value.Value) };
+	#else
+		return { std::sqrt(value.Value) };
+	#endif
+	}
+
+	inline auto Minimum(Wide left, Wide right) -> Wide
+	{
+	#if PARGON_MATH_AVX
+		return { _mm256_min_ps(left.Value, right.Value) };
+	#elif PARGON_MATH_SSE
+		return { _mm_min_ps(left.Value, right.Value) };
+	#else
+		return { left.Value < right.Value ? left.Value : right.Value };
+	#endif
+	}
+
+	inline auto Maximum(Wide left, Wide right) -> Wide
+	{
+	#if PARGON_MATH_AVX
+		return { _mm256_max_ps(left.Value, right.Value) };
+	#elif PARGON_MATH_SSE
+		return { _mm_max_ps(left.Value, right.Value) };
+	#else
+		return { left.Value > right.Value ? left.Value : right.Value };
+	#endif
+	}
+
+	inline auto ReciprocalSquareRoot(Wide value) -> Wide
+	{
+	#if PARGON_MATH_AVX
+		auto estimate = Wide{ _mm256_rsqrt_ps(value.Value) };
+	#elif PARGON_MATH_SSE
+		auto estimate = Wide{ _mm_rsqrt_ps(value.Value) };
+	#else
+		auto estimate = Wide{ 1.0f / std::sqrt(value.Value) };
+	#endif
+
+	#if PARGON_MATH_SSE
+		auto halfValue = Wide::Broadcast(0.5f) * value;
+		estimate = estimate * (Wide::Broadcast(1.5f) - halfValue * estimate * estimate);
+	#endif
+
+		return estimate;
+	}
+
+	inline auto Round(Wide value) -> Wide
+	{
+	#if PARGON_MATH_AVX
+		return { _mm256_round_ps(value.Value, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC) };
+	#elif PARGON_MATH_SSE
+		return { _mm_cvtepi32_ps(_mm_cvtps_epi32(value.Value)) };
+	#else
+		return { std::nearbyint(value.Value) };
+	#endif
+	}
+
+	inline void Transpose4(Wide& first, Wide& second, Wide& third, Wide& fourth)
+	{
+	#if PARGON_MATH_AVX
+		auto low01 = _mm256_unpacklo_ps(first.Value, second.Value);
+		auto high01 = _mm256_unpackhi_ps(first.Value, second.Value);
+		auto low23 = _mm256_unpacklo_ps(third.Value, fourth.Value);
+		auto high23 = _mm256_unpackhi_ps(third.Value, fourth.Value);
+
+		first.Value = _mm256_shuffle_ps(low01, low23, _MM_SHUFFLE(1, 0, 1, 0));
+		second.Value = _mm256_shuffle_ps(low01, low23, _MM_SHUFFLE(3, 2, 3, 2));
+		third.Value = _mm256_shuffle_ps(high01, high23, _MM_SHUFFLE(1, 0, 1, 0));
+		fourth.Value = _mm256_shuffle_ps(high01, high23, _MM_SHUFFLE(3, 2, 3, 2));
+	#elif PARGON_MATH_SSE
+		_MM_TRANSPOSE4_PS(first.Value, second.Value, third.Value, fourth.Value);
+	#endif
+	}
+
+	inline auto FromBits(std::uint32_t bits) -> float
+	{
+		float value;
+		std::memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+
+	inline auto ToBits(float value) -> std::uint32_t
+	{
+		std::uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		return bits;
+	}
+
+	inline auto operator&(Wide left, Wide right) -> Wide
+	{
+	#if PARGON_MATH_AVX
+		return { _mm256_and_ps(left.Value, right.Value) };
+	#elif PARGON_MATH_SSE
+		return { _mm_and_ps(left.Value, right.Value) };
+	#else
+		return { FromBits(ToBits(left.Value) & ToBits(right.Value)) };
+	#endif
+	}
+
+	inline auto operator|(Wide left, Wide right) -> Wide
+	{
+	#if PARGON_MATH_AVX
+		return { _mm256_or_ps(left.Value, right.Value) };
+	#elif PARGON_MATH_SSE
+		return { _mm_or_ps(left.Value, right.Value) };
+	#else
+		return { FromBits(ToBits(left.Value) | ToBits(right.Value)) };
+	#endif
+	}
+
+	inline auto operator^(Wide left, Wide right) -> Wide
+	{
+	#if PARGON_MATH_AVX
+		return { _mm256_xor_ps(left.Value, right.Value) };
+	#elif PARGON_MATH_SSE
+		return { _mm_xor_ps(left.Value, right.Value) };
+	#else
+		return { FromBits(ToBits(left.Value) ^ ToBits(right.Value)) };
+	#endif
+	}
+
+	inline auto AndNot(Wide mask, Wide value) -> Wide
+	{
+	#if PARGON_MATH_AVX
+		return { _mm256_andnot_ps(mask.Value, value.Value) };
+	#elif PARGON_MATH_SSE
+		return { _mm_andnot_ps(mask.Value, value.Value) };
+	#else
+		return { FromBits(~ToBits(mask.Value) & ToBits(value.Value)) };
+	#endif
+	}
+
+	inline auto LessThan(Wide left, Wide right) -> Wide
+	{
+	#if PARGON_MATH_AVX
+		return { _mm256_cmp_ps(left.Value, right.Value, _CMP_LT_OQ) };
+	#elif PARGON_MATH_SSE
+		return { _mm_cmplt_ps(left.Value, right.Value) };
+	#else
+		return { FromBits(left.Value < right.Value ? 0xFFFFFFFFu : 0u) };
+	#endif
+	}
+
+	inline auto LessThanOrEqual(Wide left, Wide right) -> Wide
+	{
+	#if PARGON_MATH_AVX
+		return { _mm256_cmp_ps(left.Value, right.Value, _CMP_LE_OQ) };
+	#elif PARGON_MATH_SSE
+		return { _mm_cmple_ps(left.Value, right.Value) };
+	#else
+		return { FromBits(left.Value <= right.Value ? 0xFFFFFFFFu : 0u) };
+	#endif
+	}
+
+	inline auto GreaterThan(Wide left, Wide right) -> Wide
+	{
+		return LessThan(right, left);
+	}
+
+	inline auto GreaterThanOrEqual(Wide left, Wide right) -> Wide
+	{
+		return LessThanOrEqual(right, left);
+	}
+
+	inline auto Select(Wide mask, Wide whenTrue, Wide whenFalse) -> Wide
+	{
+	#if PARGON_MATH_AVX
+		return { _mm256_blendv_ps(whenFalse.Value, whenTrue.Value, mask.Value) };
+	#else
+		return (mask & whenTrue) | AndNot(mask, whenFalse);
+	#endif
+	}
+
+	inline auto SignMask() -> Wide
+	{
+		return Wide::Broadcast(-0.0f);
+	}
+
+	inline auto AbsoluteValue(Wide value) -> Wide
+	{
+		return AndNot(SignMask(), value);
+	}
+
+	inline auto CopySign(Wide magnitude, Wide sign) -> Wide
+	{
+		return AbsoluteValue(magnitude) | (sign & SignMask());
+	}
+
+	inline auto MoveMask(Wide mask) -> int
+	{
+	#if PARGON_MATH_AVX
+		return _mm256_movemask_ps(mask.Value);
+	#elif PARGON_MATH_SSE
+		return _mm_movemask_ps(mask.Value);
+	#else
+		return static_cast<int>(ToBits(mask.Value) >> 31);
+	#endif
+	}
+
+	inline auto CountTrailingZeros(unsigned mask) -> int
+	{
+	#if defined(__GNUC__) || defined(__clang__)
+		return __builtin_ctz(mask);
+	#else
+		auto count = 0;
+
+		for (; !(mask & 1u); mask >>= 1)
+			count++;
+
+		return count;
+	#endif
+	}
+
+	inline void LoadInterleaved2(const float* data, Wide& x, Wide& y)
+	{
+	#if PARGON_MATH_AVX
+		__m128 lowX, lowY, highX, highY;
+		LoadInterleaved2(data, lowX, lowY);
+		LoadInterleaved2(data + 8, highX, highY);
+
+		x.Value = _mm256_set_m128(highX, lowX);
+		y.Value = _mm256_set_m128(highY, lowY);
+	#elif PARGON_MATH_SSE
+		LoadInterleaved2(data, x.Value, y.Value);
+	#else
+		x.Value = data[0];
+		y.Value = data[1];
+	#endif
+	}
+
+	inline void StoreInterleaved2(float* data, Wide x, Wide y)
+	{
+	#if PARGON_MATH_AVX
+		StoreInterleaved2(data, _mm256_castps256_ps128(x.Value), _mm256_castps256_ps128(y.Value));
+		StoreInterleaved2(data + 8, _mm256_extractf128_ps(x.Value, 1), _mm256_extractf128_ps(y.Value, 1));
+	#elif PARGON_MATH_SSE
+		StoreInterleaved2(data, x.Value, y.Value);
+	#else
+		data[0] = x.Value;
+		data[1] = y.Value;
+	#endif
+	}
+
+	inline void LoadInterleaved3(const float* data, Wide& x, Wide& y, Wide& z)
+	{
+	#if PARGON_MATH_AVX
+		__m128 lowX, lowY, lowZ, highX, highY, highZ;
+		LoadInterleaved3(data, lowX, lowY, lowZ);
+		LoadInterleaved3(data + 12, highX, highY, highZ);
+
+		x.Value = _mm256_set_m128(highX, lowX);
+		y.Value = _mm256_set_m128(highY, lowY);
+		z.Value = _mm256_set_m128(highZ, lowZ);
+	#elif PARGON_MATH_SSE
+		LoadInterleaved3(data, x.Value, y.Value, z.Value);
+	#else
+		x.Value = data[0];
+		y.Value = data[1];
+		z.Value = data[2];
+	#endif
+	}
+
+	inline void StoreInterleaved3(float* data, Wide x, Wide y, Wide z)
+	{
+	#if PARGON_MATH_AVX
+		StoreInterleaved3(data, _mm256_castps256_ps128(x.Value), _mm256_castps256_ps128(y.Value), _mm256_castps256_ps128(z.Value));
+		StoreInterleaved3(data + 12, _mm256_extractf128_ps(x.Value, 1), _mm256_extractf128_ps(y.Value, 1), _mm256_extractf128_ps(z.Value, 1));
+	#elif PARGON_MATH_SSE
+		StoreInterleaved3(data, x.Value, y.Value, z.Value);
+	#else
+		data[0] = x.Value;
+		data[1] = y.Value;
+		data[2] = z.Value;
+	#endif
+	}
+}
@@ -0,0 +1,378 @@
+#include "Pargon/Math/Affine.h"
+#include "Pargon/Math/DualQuaternion.h"
+#include "Pargon/Math/Matrix.h"
+#include "Pargon/Math/Skinning.h"
+#include "Pargon/Math/Stream.h"
+#include "Core/Simd.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+using namespace Pargon;
+
+namespace
+{
+	constexpr int _maximumInfluences = 8;
+
+	struct MatrixPalette
+	{
+		static constexpr int RowCount = 4;
+
+		const Matrix4x4* Matrices;
+
+		auto GetRow(int bone, int row) const -> const float*
+		{
+			return Matrices[bone].Elements.begin() + row * 4;
+		}
+	};
+
+	struct AffinePalette
+	{
+		static constexpr int RowCount = 3;
+
+		const Affine3x4* Transforms;
+
+		auto GetRow(int bone, int row) const -> const float*
+		{
+			return Transforms[bone].Elements.begin() + row * 4;
+		}
+	};
+
+	struct DualQuaternionPalette
+	{
+		const DualQuaternion* Transforms;
+	};
+
+#if PARGON_MATH_SSE
+	void ToMatrixRows(const MatrixPalette&, __m128 (&)[4])
+	{
+	}
+
+	void ToMatrixRows(const AffinePalette&, __m128 (&rows)[4])
+	{
+		rows[3] = _mm_setzero_ps();
+		_MM_TRANSPOSE4_PS(rows[0], rows[1], rows[2], rows[3]);
+	}
+
+	template<typename Palette>
+	void LoadBone(const Palette& palette, int bone, __m128 (&rows)[4])
+	{
+		for (auto row = 0; row < Palette::RowCount; row++)
+			rows[row] = _mm_loadu_ps(palette.GetRow(bone, row));
+
+		ToMatrixRows(palette, rows);
+	}
+
+	template<typename Palette>
+	void BlendBones(const Palette& palette, const std::uint16_t* bones, const float* weights, int influences, __m128 (&rows)[4])
+	{
+		for (auto row = 0; row < Palette::RowCount; row++)
+			rows[row] = _mm_setzero_ps();
+
+		for (auto influence = 0; influence < influences; influence++)
+		{
+			auto weight = _mm_set1_ps(weights[influence]);
+
+			for (auto row = 0; row < Palette::RowCount; row++)
+				rows[row] = Simd::MultiplyAdd(weight, _mm_loadu_ps(palette.GetRow(bones[influence], row)), rows[row]);
+		}
+
+		ToMatrixRows(palette, rows);
+	}
+
+	auto TransformVector(const __m128 (&rows)[4], const float* vector) -> __m128
+	{
+		auto result = _mm_mul_ps(_mm_set1_ps(vector[0]), rows[0]);
+		result = Simd::MultiplyAdd(_mm_set1_ps(vector[1]), rows[1], result);
+		return Simd::MultiplyAdd(_mm_set1_ps(vector[2]), rows[2], result);
+	}
+
+	void Store3(float* data, __m128 value)
+	{
+		_mm_storel_pi(reinterpret_cast<__m64*>(data), value);
+		_mm_store_ss(data + 2, _mm_movehl_ps(value, value));
+	}
+
+	template<typename Palette>
+	void SkinVertex(const Palette& palette, const std::uint16_t* bones, const float* weights, int influences, SkinningMethod method, const float* position, const float* normal, float* skinnedPosition, float* skinnedNormal)
+	{
+		__m128 rows[4];
+		__m128 resultPosition, resultNormal;
+
+		if (method == SkinningMethod::BlendMatrices)
+		{
+			BlendBones(palette, bones, weights, influences, rows);
+
+			resultPosition = _mm_add_ps(TransformVector(rows, position), rows[3]);
+
+			if (normal)
+				resultNormal = TransformVector(rows, normal);
+		}
+		else
+		{
+			resultPosition = _mm_setzero_ps();
+			resultNormal = _mm_setzero_ps();
+
+			for (auto influence = 0; influence < influences; influence++)
+			{
+				auto weight = _mm_set1_ps(weights[influence]);
+				LoadBone(palette, bones[influence], rows);
+
+				resultPosition = Simd::MultiplyAdd(weight, _mm_add_ps(TransformVector(rows, position), rows[3]), resultPosition);
+
+				if (normal)
+					resultNormal = Simd::MultiplyAdd(weight, TransformVector(rows, normal), resultNormal);
+			}
+		}
+
+		Store3(skinnedPosition, resultPosition);
+
+		if (normal)
+		{
+			auto length = Simd::Dot3(resultNormal, resultNormal);
+			auto valid = _mm_cmpgt_ps(length, _mm_setzero_ps());
+
+			Store3(skinnedNormal, _mm_and_ps(valid, _mm_div_ps(resultNormal, _mm_sqrt_ps(length))));
+		}
+	}
+	auto Dot4(__m128 left, __m128 right) -> __m128
+	{
+		auto product = _mm_mul_ps(left, right);
+		auto sum = _mm_add_ps(product, Simd::Swizzle<1, 0, 3, 2>(product));
+		return _mm_add_ps(sum, Simd::Swizzle<2, 3, 0, 1>(sum));
+	}
+
+	auto Rotate(__m128 rotation, __m128 vector) -> __m128
+	{
+		auto first = Simd::Cross(rotation, vector);
+		auto second = Simd::Cross(rotation, first);
+		auto offset = Simd::MultiplyAdd(Simd::Splat<3>(rotation), first, second);
+
+		return Simd::MultiplyAdd(_mm_set1_ps(2.0f), offset, vector);
+	}
+
+	void SkinVertex(const DualQuaternionPalette& palette, const std::uint16_t* bones, const float* weights, int influences, SkinningMethod, const float* position, const float* normal, float* skinnedPosition, float* skinnedNormal)
+	{
+		auto pivot = _mm_loadu_ps(&palette.Transforms[bones[0]].Real.X);
+		auto sign = _mm_set1_ps(-0.0f);
+		auto real = _mm_setzero_ps();
+		auto dual = _mm_setzero_ps();
+
+		for (auto influence = 0; influence < influences; influence++)
+		{
+			auto& transform = palette.Transforms[bones[influence]];
+			auto transformReal = _mm_loadu_ps(&transform.Real.X);
+			auto weight = _mm_xor_ps(_mm_set1_ps(weights[influence]), _mm_and_ps(Dot4(pivot, transformReal), sign));
+
+			real = Simd::MultiplyAdd(weight, transformReal, real);
+			dual = Simd::MultiplyAdd(weight, _mm_loadu_ps(&transform.Dual.X), dual);
+		}
+
+		auto scale = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(Dot4(real, real)));
+		real = _mm_mul_ps(real, scale);
+		dual = _mm_mul_ps(dual, scale);
+
+		auto translation = _mm_sub_ps(_mm_mul_ps(Simd::Splat<3>(real), dual), _mm_mul_ps(Simd::Splat<3>(dual), real));
+		translation = _mm_mul_ps(_mm_set1_ps(2.0f), _mm_add_ps(translation, Simd::Cross(real, dual)));
+
+		Store3(skinnedPosition, _mm_add_ps(Rotate(real, _mm_setr_ps(position[0], position[1], position[2], 0.0f)), translation));
+
+		if (normal)
+			Store3(skinnedNormal, Rotate(real, _mm_setr_ps(normal[0], normal[1], normal[2], 0.0f)));
+	}
+#else
+	template<typename Palette>
+	auto GetElement(const Palette& palette, int bone, int row, int column) -> float
+	{
+		return Palette::RowCount == 4 ? palette.GetRow(bone, row)[column] : palette.GetRow(bone, column)[row];
+	}
+
+	template<typename Palette>
+	void LoadBone(const Palette& palette, int bone, float (&rows)[4][3])
+	{
+		for (auto row = 0; row < 4; row++)
+		{
+			for (auto column = 0; column < 3; column++)
+				rows[row][column] = GetElement(palette, bone, row, column);
+		}
+	}
+
+	void TransformVector(const float (&rows)[4][3], const float* vector, float weight, bool point, float* result)
+	{
+		for (auto column = 0; column < 3; column++)
+			result[column] += weight * (vector[0] * rows[0][column] + vector[1] * rows[1][column] + vector[2] * rows[2][column] + (point ? rows[3][column] : 0.0f));
+	}
+
+	template<typename Palette>
+	void SkinVertex(const Palette& palette, const std::uint16_t* bones, const float* weights, int influences, SkinningMethod method, const float* position, const float* normal, float* skinnedPosition, float* skinnedNormal)
+	{
+		float rows[4][3];
+		float resultPosition[3] = { 0.0f, 0.0f, 0.0f };
+		float resultNormal[3] = { 0.0f, 0.0f, 0.0f };
+
+		if (method == SkinningMethod::BlendMatrices)
+		{
+			float blended[4][3] = {};
+
+			for (auto influence = 0; influence < influences; influence++)
+			{
+				LoadBone(palette, bones[influence], rows);
+
+				for (auto row = 0; row < 4; row++)
+				{
+					for (auto column = 0; column < 3; column++)
+						blended[row][column] += weights[influence] * rows[row][column];
+				}
+			}
+
+			TransformVector(blended, position, 1.0f, true, resultPosition);
+
+			if (normal)
+				TransformVector(blended, normal, 1.0f, false, resultNormal);
+		}
+		else
+		{
+			for (auto influence = 0; influence < influences; influence++)
+			{
+				LoadBone(palette, bones[influence], rows);
+				TransformVector(rows, position, weights[influence], true, resultPosition);
+
+				if (normal)
+					TransformVector(rows, normal, weights[influence], false, resultNormal);
+			}
+		}
+
+		std::copy(resultPosition, resultPosition + 3, skinnedPosition);
+
+		if (normal)
+		{
+			auto length = std::sqrt(resultNormal[0] * resultNormal[0] + resultNormal[1] * resultNormal[1] + resultNormal[2] * resultNormal[2]);
+			auto scale = length > 0.0f ? 1.0f / length : 0.0f;
+
+			for (auto column = 0; column < 3; column++)
+				skinnedNormal[column] = resultNormal[column] * scale;
+		}
+	}
+
+	void Accumulate(Quaternion& sum, Quaternion value, float weight)
+	{
+		sum.X += value.X * weight;
+		sum.Y += value.Y * weight;
+		sum.Z += value.Z * weight;
+		sum.W += value.W * weight;
+	}
+
+	void SkinVertex(const DualQuaternionPalette& palette, const std::uint16_t* bones, const float* weights, int influences, SkinningMethod, const float* position, const float* normal, float* skinnedPosition, float* skinnedNormal)
+	{
+		auto pivot = palette.Transforms[bones[0]].Real;
+		auto blended = DualQuaternion{ { 0.0f, 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f, 0.0f } };
+
+		for (auto influence = 0; influence < influences; influence++)
+		{
+			auto& transform = palette.Transforms[bones[influence]];
+			auto dot = pivot.X * transform.Real.X + pivot.Y * transform.Real.Y + pivot.Z * transform.Real.Z + pivot.W * transform.Real.W;
+			auto weight = dot < 0.0f ? -weights[influence] : weights[influence];
+
+			Accumulate(blended.Real, transform.Real, weight);
+			Accumulate(blended.Dual, transform.Dual, weight);
+		}
+
+		blended.Normalize();
+
+		auto skinned = blended.TransformPoint({ position[0], position[1], position[2] });
+		skinnedPosition[0] = skinned.X;
+		skinnedPosition[1] = skinned.Y;
+		skinnedPosition[2] = skinned.Z;
+
+		if (normal)
+		{
+			auto rotated = blended.TransformVector({ normal[0], normal[1], normal[2] });
+			skinnedNormal[0] = rotated.X;
+			skinnedNormal[1] = rotated.Y;
+			skinnedNormal[2] = rotated.Z;
+		}
+	}
+#endif
+
+	template<typename Palette>
+	void SkinArrays(const Vector3* positions, const Vector3* normals, int count, const std::uint16_t* bones, const float* weights, int influences, const Palette& palette, Vector3* skinnedPositions, Vector3* skinnedNormals, SkinningMethod method)
+	{
+		assert(influences > 0 && influences <= _maximumInfluences);
+		assert(!normals || skinnedNormals);
+
+		for (auto index = 0; index < count; index++)
+		{
+			auto offset = index * influences;
+			SkinVertex(palette, bones + offset, weights + offset, influences, method, &positions[index].X, normals ? &normals[index].X : nullptr, &skinnedPositions[index].X, normals ? &skinnedNormals[index].X : nullptr);
+		}
+	}
+
+	template<typename Palette>
+	void SkinStreams(const Vector3Stream& positions, const Vector3Stream& normals, int start, int count, const std::uint16_t* bones, const float* weights, int influences, const Palette& palette, Vector3Stream& skinnedPositions, Vector3Stream& skinnedNormals, SkinningMethod method)
+	{
+		assert(influences > 0 && influences <= _maximumInfluences);
+		assert(start >= 0 && start + count <= positions.Count() && start + count <= skinnedPositions.Count());
+
+		auto hasNormals = normals.Count() > 0;
+		assert(!hasNormals || (start + count <= normals.Count() && start + count <= skinnedNormals.Count()));
+
+		for (auto index = start; index < start + count; index++)
+		{
+			float position[3] = { positions.GetX()[index], positions.GetY()[index], positions.GetZ()[index] };
+			float normal[3] = { 0.0f, 0.0f, 0.0f };
+			float skinnedPosition[3], skinnedNormal[3];
+
+			if (hasNormals)
+			{
+				normal[0] = normals.GetX()[index];
+				normal[1] = normals.GetY()[index];
+				normal[2] = normals.GetZ()[index];
+			}
+
+			auto offset = index * influences;
+			SkinVertex(palette, bones + offset, weights + offset, influences, method, position, hasNormals ? normal : nullptr, skinnedPosition, skinnedNormal);
+
+			skinnedPositions.GetX()[index] = skinnedPosition[0];
+			skinnedPositions.GetY()[index] = skinnedPosition[1];
+			skinnedPositions.GetZ()[index] = skinnedPosition[2];
+
+			if (hasNormals)
+			{
+				skinnedNormals.GetX()[index] = skinnedNormal[0];
+				skinnedNormals.GetY()[index] = skinnedNormal[1];
+				skinnedNormals.GetZ()[index] = skinnedNormal[2];
+			}
+		}
+	}
+}
+
+void Pargon::SkinVertices(const Vector3* positions, const Vector3* normals, int count, const std::uint16_t* bones, const float* weights, int influences, const Matrix4x4* palette, Vector3* skinnedPositions, Vector3* skinnedNormals, SkinningMethod method)
+{
+	SkinArrays(positions, normals, count, bones, weights, influences, MatrixPalette{ palette }, skinnedPositions, skinnedNormals, method);
+}
+
+void Pargon::SkinVertices(const Vector3* positions, const Vector3* normals, int count, const std::uint16_t* bones, const float* weights, int influences, const Affine3x4* palette, Vector3* skinnedPositions, Vector3* skinnedNormals, SkinningMethod method)
+{
+	SkinArrays(positions, normals, count, bones, weights, influences, AffinePalette{ palette }, skinnedPositions, skinnedNormals, method);
+}
+
+void Pargon::SkinVertices(const Vector3Stream& positions, const Vector3Stream& normals, int start, int count, const std::uint16_t* bones, const float* weights, int influences, const Matrix4x4* palette, Vector3Stream& skinnedPositions, Vector3Stream& skinnedNormals, SkinningMethod method)
+{
+	SkinStreams(positions, normals, start, count, bones, weights, influences, MatrixPalette{ palette }, skinnedPositions, skinnedNormals, method);
+}
+
+void Pargon::SkinVertices(const Vector3Stream& positions, const Vector3Stream& normals, int start, int count, const std::uint16_t* bones, const float* weights, int influences, const Affine3x4* palette, Vector3Stream& skinnedPositions, Vector3Stream& skinnedNormals, SkinningMethod method)
+{
+	SkinStreams(positions, normals, start, count, bones, weights, influences, AffinePalette{ palette }, skinnedPositions, skinnedNormals, method);
+}
+
+void Pargon::SkinVertices(const Vector3* positions, const Vector3* normals, int count, const std::uint16_t* bones, const float* weights, int influences, const DualQuaternion* palette, Vector3* skinnedPositions, Vector3* skinnedNormals)
+{
+	SkinArrays(positions, normals, count, bones, weights, influences, DualQuaternionPalette{ palette }, skinnedPositions, skinnedNormals, SkinningMethod::BlendPositions);
+}
+
+void Pargon::SkinVertices(const Vector3Stream& positions, const Vector3Stream& normals, int start, int count, const std::uint16_t* bones, const float* weights, int influences, const DualQuaternion* palette, Vector3Stream& skinnedPositions, Vector3Stream& skinnedNormals)
+{
+	SkinStreams(positions, normals, start, count, bones, weights, influences, DualQuaternionPalette{ palette }, skinnedPositions, skinnedNormals, SkinningMethod::BlendPositions);
+}
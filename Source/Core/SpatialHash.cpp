@@ -0,0 +1,392 @@
+#include "Pargon/Math/SpatialHash.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+using namespace Pargon;
+
+namespace
+{
+	// Points are sorted in two counting passes, first by the top bits of their bucket so each build task can then
+	// sort one range of buckets on its own.
+	constexpr int _blockBits = 8;
+	constexpr int _blockCount = 1 << _blockBits;
+	constexpr int _maximumBucketBits = 30;
+
+	struct Cell
+	{
+		int X;
+		int Y;
+		int Z;
+	};
+
+	auto operator==(Cell left, Cell right) -> bool
+	{
+		return left.X == right.X && left.Y == right.Y && left.Z == right.Z;
+	}
+
+	auto ToCell(float value, float inverseCellSize) -> int
+	{
+		return static_cast<int>(std::floor(value * inverseCellSize));
+	}
+
+	auto GetCell(Point2 point, float inverseCellSize) -> Cell
+	{
+		return { ToCell(point.X, inverseCellSize), ToCell(point.Y, inverseCellSize), 0 };
+	}
+
+	auto GetCell(Point3 point, float inverseCellSize) -> Cell
+	{
+		return { ToCell(point.X, inverseCellSize), ToCell(point.Y, inverseCellSize), ToCell(point.Z, inverseCellSize) };
+	}
+
+	void GetCellRange(Point2 center, float radius, float inverseCellSize, Cell& minimum, Cell& maximum)
+	{
+		minimum = GetCell(Point2{ center.X - radius, center.Y - radius }, inverseCellSize);
+		maximum = GetCell(Point2{ center.X + radius, center.Y + radius }, inverseCellSize);
+	}
+
+	void GetCellRange(Point3 center, float radius, float inverseCellSize, Cell& minimum, Cell& maximum)
+	{
+		minimum = GetCell(Point3{ center.X - radius, center.Y - radius, center.Z - radius }, inverseCellSize);
+		maximum = GetCell(Point3{ center.X + radius, center.Y + radius, center.Z + radius }, inverseCellSize);
+	}
+
+	auto GetBucket(Cell cell, int bucketBits) -> std::uint32_t
+	{
+		auto hash = (static_cast<std::uint32_t>(cell.X) * 73856093u) ^ (static_cast<std::uint32_t>(cell.Y) * 19349663u) ^ (static_cast<std::uint32_t>(cell.Z) * 83492791u);
+		return (hash * 2654435769u) >> (32 - bucketBits);
+	}
+
+	auto GetRangeStart(int count, int taskCount, int task) -> int
+	{
+		return static_cast<int>(static_cast<std::int64_t>(count) * task / taskCount);
+	}
+
+	template<typename Type>
+	void Append(const Type& value, Type* results, int capacity, int& total)
+	{
+		if (total < capacity)
+			results[total] = value;
+
+		total++;
+	}
+
+	template<typename PointType, typename Visit>
+	void ForEachCell(PointType center, float radius, float inverseCellSize, Visit visit)
+	{
+		Cell minimum, maximum;
+		GetCellRange(center, radius, inverseCellSize, minimum, maximum);
+
+		for (auto z = minimum.Z; z <= maximum.Z; z++)
+		{
+			for (auto y = minimum.Y; y <= maximum.Y; y++)
+			{
+				for (auto x = minimum.X; x <= maximum.X; x++)
+					visit(Cell{ x, y, z });
+			}
+		}
+	}
+}
+
+template<typename PointType>
+struct SpatialHashGrid<PointType>::Data
+{
+	std::vector<int> BucketStarts;
+	std::vector<int> Indices;
+	std::vector<PointType> Points;
+
+	std::vector<std::uint32_t> Buckets;
+	std::vector<int> BlockCounts;
+	std::vector<int> BlockOrder;
+	std::vector<int> Cursors;
+};
+
+template<typename PointType>
+SpatialHashGrid<PointType>::SpatialHashGrid(float cellSize, int taskCount) :
+	_cellSize(cellSize),
+	_inverseCellSize(1.0f / cellSize),
+	_taskCount(taskCount),
+	_data(std::make_unique<Data>())
+{
+	assert(cellSize > 0.0f);
+	assert(taskCount > 0);
+}
+
+template<typename PointType>
+SpatialHashGrid<PointType>::SpatialHashGrid(const SpatialHashGrid& copy) :
+	_cellSize(copy._cellSize),
+	_inverseCellSize(copy._inverseCellSize),
+	_taskCount(copy._taskCount),
+	_bucketBits(copy._bucketBits),
+	_data(std::make_unique<Data>(*copy._data))
+{
+}
+
+template<typename PointType>
+SpatialHashGrid<PointType>::SpatialHashGrid(SpatialHashGrid&& move) noexcept = default;
+
+template<typename PointType>
+SpatialHashGrid<PointType>::~SpatialHashGrid() = default;
+
+template<typename PointType>
+auto SpatialHashGrid<PointType>::operator=(const SpatialHashGrid& copy) -> SpatialHashGrid&
+{
+	if (!_data)
+		_data = std::make_unique<Data>(*copy._data);
+	else if (this != &copy)
+		*_data = *copy._data;
+
+	_cellSize = copy._cellSize;
+	_inverseCellSize = copy._inverseCellSize;
+	_taskCount = copy._taskCount;
+	_bucketBits = copy._bucketBits;
+	return *this;
+}
+
+template<typename PointType>
+auto SpatialHashGrid<PointType>::operator=(SpatialHashGrid&& move) noexcept -> SpatialHashGrid&
+{
+	std::swap(_cellSize, move._cellSize);
+	std::swap(_inverseCellSize, move._inverseCellSize);
+	std::swap(_taskCount, move._taskCount);
+	std::swap(_bucketBits, move._bucketBits);
+	std::swap(_data, move._data);
+	return *this;
+}
+
+template<typename PointType>
+auto SpatialHashGrid<PointType>::GetCellSize() const -> float
+{
+	return _cellSize;
+}
+
+template<typename PointType>
+auto SpatialHashGrid<PointType>::GetTaskCount() const -> int
+{
+	return _taskCount;
+}
+
+template<typename PointType>
+auto SpatialHashGrid<PointType>::Count() const -> int
+{
+	return static_cast<int>(_data->Indices.size());
+}
+
+template<typename PointType>
+void SpatialHashGrid<PointType>::Build(const PointType* points, int count)
+{
+	BeginBuild(points, count);
+
+	for (auto stage = 0; stage < BuildStageCount; stage++)
+	{
+		for (auto task = 0; task < _taskCount; task++)
+			BuildTask(stage, task);
+	}
+
+	EndBuild();
+}
+
+template<typename PointType>
+void SpatialHashGrid<PointType>::BeginBuild(const PointType* points, int count)
+{
+	assert(count >= 0);
+
+	_buildPoints = points;
+	_buildCount = count;
+	_bucketBits = _blockBits;
+
+	while (_bucketBits < _maximumBucketBits && (1 << _bucketBits) < count * 2)
+		_bucketBits++;
+
+	auto bucketCount = 1 << _bucketBits;
+
+	_data->BucketStarts.resize(bucketCount + 1);
+	_data->BucketStarts[bucketCount] = count;
+	_data->Cursors.resize(bucketCount);
+	_data->Indices.resize(count);
+	_data->Points.resize(count);
+	_data->Buckets.resize(count);
+	_data->BlockOrder.resize(count);
+	_data->BlockCounts.assign(static_cast<std::size_t>(_taskCount) * _blockCount, 0);
+}
+
+template<typename PointType>
+void SpatialHashGrid<PointType>::BuildTask(int stage, int task)
+{
+	assert(stage >= 0 && stage < BuildStageCount);
+	assert(task >= 0 && task < _taskCount);
+
+	auto shift = _bucketBits - _blockBits;
+
+	if (stage == 0)
+	{
+		auto counts = _data->BlockCounts.data() + static_cast<std::size_t>(task) * _blockCount;
+		auto end = GetRangeStart(_buildCount, _taskCount, task + 1);
+
+		for (auto index = GetRangeStart(_buildCount, _taskCount, task); index < end; index++)
+		{
+			auto bucket = GetBucket(GetCell(_buildPoints[index], _inverseCellSize), _bucketBits);
+			_data->Buckets[index] = bucket;
+			counts[bucket >> shift]++;
+		}
+	}
+	else if (stage == 1)
+	{
+		// Each task finds where its points go in every block from the counts of all tasks, which keeps the order of
+		// points within a block the same as the input regardless of how tasks were scheduled.
+
+		int offsets[_blockCount];
+		auto offset = 0;
+
+		for (auto block = 0; block < _blockCount; block++)
+		{
+			offsets[block] = offset;
+
+			for (auto counter = 0; counter < _taskCount; counter++)
+			{
+				auto count = _data->BlockCounts[static_cast<std::size_t>(counter) * _blockCount + block];
+				offsets[block] += counter < task ? count : 0;
+				offset += count;
+			}
+		}
+
+		auto end = GetRangeStart(_buildCount, _taskCount, task + 1);
+
+		for (auto index = GetRangeStart(_buildCount, _taskCount, task); index < end; index++)
+			_data->BlockOrder[offsets[_data->Buckets[index] >> shift]++] = index;
+	}
+	else
+	{
+		auto firstBlock = GetRangeStart(_blockCount, _taskCount, task);
+		auto lastBlock = GetRangeStart(_blockCount, _taskCount, task + 1);
+		auto firstBucket = firstBlock << shift;
+		auto lastBucket = lastBlock << shift;
+		auto start = GetBlockStart(firstBlock);
+		auto end = GetBlockStart(lastBlock);
+
+		std::fill(_data->BucketStarts.begin() + firstBucket, _data->BucketStarts.begin() + lastBucket, 0);
+
+		for (auto order = start; order < end; order++)
+			_data->BucketStarts[_data->Buckets[_data->BlockOrder[order]]]++;
+
+		for (auto bucket = firstBucket, position = start; bucket < lastBucket; bucket++)
+		{
+			auto count = _data->BucketStarts[bucket];
+			_data->BucketStarts[bucket] = position;
+			_data->Cursors[bucket] = position;
+			position += count;
+		}
+
+		for (auto order = start; order < end; order++)
+		{
+			auto index = _data->BlockOrder[order];
+			auto position = _data->Cursors[_data->Buckets[index]]++;
+
+			_data->Indices[position] = index;
+			_data->Points[position] = _buildPoints[index];
+		}
+	}
+}
+
+template<typename PointType>
+void SpatialHashGrid<PointType>::EndBuild()
+{
+	_buildPoints = nullptr;
+	_buildCount = 0;
+}
+
+template<typename PointType>
+auto SpatialHashGrid<PointType>::Query(PointType center, float radius, int* results, int capacity) const -> int
+{
+	auto& bucketStarts = _data->BucketStarts;
+	auto& points = _data->Points;
+	auto& indices = _data->Indices;
+	auto total = 0;
+
+	if (indices.empty())
+		return total;
+
+	auto radiusSquared = radius * radius;
+
+	// Buckets can hold several cells, so points are also checked against the cell being visited to keep a bucket
+	// reached from two cells from reporting its points twice.
+
+	ForEachCell(center, radius, _inverseCellSize, [&](Cell cell)
+	{
+		auto bucket = GetBucket(cell, _bucketBits);
+
+		for (auto position = bucketStarts[bucket]; position < bucketStarts[bucket + 1]; position++)
+		{
+			if ((points[position] - center).GetLengthSquared() <= radiusSquared && GetCell(points[position], _inverseCellSize) == cell)
+				Append(indices[position], results, capacity, total);
+		}
+	});
+
+	return total;
+}
+
+template<typename PointType>
+auto SpatialHashGrid<PointType>::FindPairs(float radius, Pair* pairs, int capacity) const -> int
+{
+	return FindPairs(radius, 0, Count(), pairs, capacity);
+}
+
+template<typename PointType>
+auto SpatialHashGrid<PointType>::FindPairs(float radius, int task, Pair* pairs, int capacity) const -> int
+{
+	assert(task >= 0 && task < _taskCount);
+	return FindPairs(radius, GetRangeStart(Count(), _taskCount, task), GetRangeStart(Count(), _taskCount, task + 1), pairs, capacity);
+}
+
+template<typename PointType>
+auto SpatialHashGrid<PointType>::GetBlockStart(int block) const -> int
+{
+	auto start = 0;
+
+	for (auto task = 0; task < _taskCount; task++)
+	{
+		auto counts = _data->BlockCounts.data() + static_cast<std::size_t>(task) * _blockCount;
+		start = std::accumulate(counts, counts + block, start);
+	}
+
+	return start;
+}
+
+template<typename PointType>
+auto SpatialHashGrid<PointType>::FindPairs(float radius, int start, int end, Pair* pairs, int capacity) const -> int
+{
+	auto& bucketStarts = _data->BucketStarts;
+	auto& points = _data->Points;
+	auto& indices = _data->Indices;
+	auto radiusSquared = radius * radius;
+	auto total = 0;
+
+	// Each pair is found from the point that comes first in sorted order.
+
+	for (auto first = start; first < end; first++)
+	{
+		auto point = points[first];
+
+		ForEachCell(point, radius, _inverseCellSize, [&](Cell cell)
+		{
+			auto bucket = GetBucket(cell, _bucketBits);
+
+			for (auto second = std::max(bucketStarts[bucket], first + 1); second < bucketStarts[bucket + 1]; second++)
+			{
+				if ((points[second] - point).GetLengthSquared() <= radiusSquared && GetCell(points[second], _inverseCellSize) == cell)
+					Append(Pair{ std::min(indices[first], indices[second]), std::max(indices[first], indices[second]) }, pairs, capacity, total);
+			}
+		});
+	}
+
+	return total;
+}
+
+template class Pargon::SpatialHashGrid<Point2>;
+template class Pargon::SpatialHashGrid<Point3>;
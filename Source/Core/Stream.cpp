@@ -0,0 +1,688 @@
+#include "Pargon/Math/Stream.h"
+#include "Core/Simd.h"
+
+#include <algorithm>
+#include <cassert>
+#include <new>
+
+using namespace Pargon;
+
+namespace
+{
+	void Deinterleave2(const float* source, int count, float* x, float* y)
+	{
+		auto index = 0;
+
+#if PARGON_MATH_SSE
+		for (; index + 4 <= count; index += 4)
+		{
+			__m128 blockX, blockY;
+			Simd::LoadInterleaved2(source + index * 2, blockX, blockY);
+
+			_mm_store_ps(x + index, blockX);
+			_mm_store_ps(y + index, blockY);
+		}
+#endif
+
+		for (; index < count; index++)
+		{
+			x[index] = source[index * 2 + 0];
+			y[index] = source[index * 2 + 1];
+		}
+	}
+
+	void Interleave2(const float* x, const float* y, int count, float* destination)
+	{
+		auto index = 0;
+
+#if PARGON_MATH_SSE
+		for (; index + 4 <= count; index += 4)
+			Simd::StoreInterleaved2(destination + index * 2, _mm_load_ps(x + index), _mm_load_ps(y + index));
+#endif
+
+		for (; index < count; index++)
+		{
+			destination[index * 2 + 0] = x[index];
+			destination[index * 2 + 1] = y[index];
+		}
+	}
+
+	void Deinterleave3(const float* source, int count, float* x, float* y, float* z)
+	{
+		auto index = 0;
+
+#if PARGON_MATH_SSE
+		for (; index + 4 <= count; index += 4)
+		{
+			__m128 blockX, blockY, blockZ;
+			Simd::LoadInterleaved3(source + index * 3, blockX, blockY, blockZ);
+
+			_mm_store_ps(x + index, blockX);
+			_mm_store_ps(y + index, blockY);
+			_mm_store_ps(z + index, blockZ);
+		}
+#endif
+
+		for (; index < count; index++)
+		{
+			x[index] = source[index * 3 + 0];
+			y[index] = source[index * 3 + 1];
+			z[index] = source[index * 3 + 2];
+		}
+	}
+
+	void Interleave3(const float* x, const float* y, const float* z, int count, float* destination)
+	{
+		auto index = 0;
+
+#if PARGON_MATH_SSE
+		for (; index + 4 <= count; index += 4)
+			Simd::StoreInterleaved3(destination + index * 3, _mm_load_ps(x + index), _mm_load_ps(y + index), _mm_load_ps(z + index));
+#endif
+
+		for (; index < count; index++)
+		{
+			destination[index * 3 + 0] = x[index];
+			destination[index * 3 + 1] = y[index];
+			destination[index * 3 + 2] = z[index];
+		}
+	}
+
+	void Deinterleave4(const float* source, int count, float* x, float* y, float* z, float* w)
+	{
+		auto index = 0;
+
+#if PARGON_MATH_SSE
+		for (; index + 4 <= count; index += 4)
+		{
+			auto blockX = _mm_loadu_ps(source + index * 4 + 0);
+			auto blockY = _mm_loadu_ps(source + index * 4 + 4);
+			auto blockZ = _mm_loadu_ps(source + index * 4 + 8);
+			auto blockW = _mm_loadu_ps(source + index * 4 + 12);
+
+			_MM_TRANSPOSE4_PS(blockX, blockY, blockZ, blockW);
+
+			_mm_store_ps(x + index, blockX);
+			_mm_store_ps(y + index, blockY);
+			_mm_store_ps(z + index, blockZ);
+			_mm_store_ps(w + index, blockW);
+		}
+#endif
+
+		for (; index < count; index++)
+		{
+			x[index] = source[index * 4 + 0];
+			y[index] = source[index * 4 + 1];
+			z[index] = source[index * 4 + 2];
+			w[index] = source[index * 4 + 3];
+		}
+	}
+
+	void Interleave4(const float* x, const float* y, const float* z, const float* w, int count, float* destination)
+	{
+		auto index = 0;
+
+#if PARGON_MATH_SSE
+		for (; index + 4 <= count; index += 4)
+		{
+			auto block0 = _mm_load_ps(x + index);
+			auto block1 = _mm_load_ps(y + index);
+			auto block2 = _mm_load_ps(z + index);
+			auto block3 = _mm_load_ps(w + index);
+
+			_MM_TRANSPOSE4_PS(block0, block1, block2, block3);
+
+			_mm_storeu_ps(destination + index * 4 + 0, block0);
+			_mm_storeu_ps(destination + index * 4 + 4, block1);
+			_mm_storeu_ps(destination + index * 4 + 8, block2);
+			_mm_storeu_ps(destination + index * 4 + 12, block3);
+		}
+#endif
+
+		for (; index < count; index++)
+		{
+			destination[index * 4 + 0] = x[index];
+			destination[index * 4 + 1] = y[index];
+			destination[index * 4 + 2] = z[index];
+			destination[index * 4 + 3] = w[index];
+		}
+	}
+}
+
+FloatStream::FloatStream(int count)
+{
+	SetCount(count);
+}
+
+FloatStream::FloatStream(const float* values, int count)
+{
+	SetCount(count);
+	std::copy(values, values + count, _data);
+}
+
+FloatStream::FloatStream(const FloatStream& copy)
+{
+	SetCount(copy._count);
+	std::copy(copy._data, copy._data + copy._count, _data);
+}
+
+FloatStream::FloatStream(FloatStream&& move) noexcept :
+	_data(move._data),
+	_count(move._count),
+	_capacity(move._capacity)
+{
+	move._data = nullptr;
+	move._count = 0;
+	move._capacity = 0;
+}
+
+FloatStream::~FloatStream()
+{
+	if (_data)
+		::operator delete(_data, std::align_val_t(Alignment));
+}
+
+auto FloatStream::operator=(const FloatStream& copy) -> FloatStream&
+{
+	if (this != &copy)
+	{
+		SetCount(copy._count);
+		std::copy(copy._data, copy._data + copy._count, _data);
+	}
+
+	return *this;
+}
+
+auto FloatStream::operator=(FloatStream&& move) noexcept -> FloatStream&
+{
+	std::swap(_data, move._data);
+	std::swap(_count, move._count);
+	std::swap(_capacity, move._capacity);
+	return *this;
+}
+
+auto FloatStream::Count() const -> int
+{
+	return _count;
+}
+
+auto FloatStream::PaddedCount() const -> int
+{
+	return (_count + Padding - 1) / Padding * Padding;
+}
+
+auto FloatStream::Data() -> float*
+{
+	return _data;
+}
+
+auto FloatStream::Data() const -> const float*
+{
+	return _data;
+}
+
+auto FloatStream::Item(int index) -> float&
+{
+	assert(index >= 0 && index < _count);
+	return _data[index];
+}
+
+auto FloatStream::Item(int index) const -> float
+{
+	assert(index >= 0 && index < _count);
+	return _data[index];
+}
+
+void FloatStream::SetCount(int count)
+{
+	if (count > _capacity)
+		Reserve(std::max(count, _capacity * 2));
+
+	// Kernels process whole blocks and may leave results in the padding, so everything from the smaller count to the
+	// end of the larger padded block is cleared to keep the padding lanes zero after the stream grows or shrinks.
+
+	auto end = (std::max(count, _count) + Padding - 1) / Padding * Padding;
+	std::fill(_data + std::min(count, _count), _data + end, 0.0f);
+
+	_count = count;
+}
+
+void FloatStream::Add(float value)
+{
+	SetCount(_count + 1);
+	_data[_count - 1] = value;
+}
+
+void FloatStream::CopyTo(float* values) const
+{
+	std::copy(_data, _data + _count, values);
+}
+
+void FloatStream::Reserve(int capacity)
+{
+	capacity = (capacity + Padding - 1) / Padding * Padding;
+
+	auto data = static_cast<float*>(::operator new(sizeof(float) * capacity, std::align_val_t(Alignment)));
+	std::fill(data, data + capacity, 0.0f);
+
+	if (_data)
+	{
+		std::copy(_data, _data + _count, data);
+		::operator delete(_data, std::align_val_t(Alignment));
+	}
+
+	_data = data;
+	_capacity = capacity;
+}
+
+Vector2Stream::Reference::operator Vector2() const
+{
+	return { X, Y };
+}
+
+auto Vector2Stream::Reference::operator=(Vector2 vector) -> Reference&
+{
+	X = vector.X;
+	Y = vector.Y;
+	return *this;
+}
+
+auto Vector2Stream::Reference::operator=(const Reference& reference) -> Reference&
+{
+	return operator=(static_cast<Vector2>(reference));
+}
+
+Vector2Stream::Vector2Stream(int count)
+{
+	SetCount(count);
+}
+
+Vector2Stream::Vector2Stream(const Vector2* vectors, int count)
+{
+	CopyFrom(vectors, count);
+}
+
+auto Vector2Stream::Count() const -> int
+{
+	return _x.Count();
+}
+
+auto Vector2Stream::PaddedCount() const -> int
+{
+	return _x.PaddedCount();
+}
+
+auto Vector2Stream::GetX() -> float*
+{
+	return _x.Data();
+}
+
+auto Vector2Stream::GetX() const -> const float*
+{
+	return _x.Data();
+}
+
+auto Vector2Stream::GetY() -> float*
+{
+	return _y.Data();
+}
+
+auto Vector2Stream::GetY() const -> const float*
+{
+	return _y.Data();
+}
+
+auto Vector2Stream::Item(int index) -> Reference
+{
+	return { _x.Item(index), _y.Item(index) };
+}
+
+auto Vector2Stream::Item(int index) const -> Vector2
+{
+	return { _x.Item(index), _y.Item(index) };
+}
+
+void Vector2Stream::SetCount(int count)
+{
+	_x.SetCount(count);
+	_y.SetCount(count);
+}
+
+void Vector2Stream::Add(Vector2 vector)
+{
+	_x.Add(vector.X);
+	_y.Add(vector.Y);
+}
+
+void Vector2Stream::CopyFrom(const Vector2* vectors, int count)
+{
+	SetCount(count);
+	Deinterleave2(&vectors->X, count, _x.Data(), _y.Data());
+}
+
+void Vector2Stream::CopyTo(Vector2* vectors) const
+{
+	Interleave2(_x.Data(), _y.Data(), Count(), &vectors->X);
+}
+
+Vector3Stream::Reference::operator Vector3() const
+{
+	return { X, Y, Z };
+}
+
+auto Vector3Stream::Reference::operator=(Vector3 vector) -> Reference&
+{
+	X = vector.X;
+	Y = vector.Y;
+	Z = vector.Z;
+	return *this;
+}
+
+auto Vector3Stream::Reference::operator=(const Reference& reference) -> Reference&
+{
+	return operator=(static_cast<Vector3>(reference));
+}
+
+Vector3Stream::Vector3Stream(int count)
+{
+	SetCount(count);
+}
+
+Vector3Stream::Vector3Stream(const Vector3* vectors, int count)
+{
+	CopyFrom(vectors, count);
+}
+
+auto Vector3Stream::Count() const -> int
+{
+	return _x.Count();
+}
+
+auto Vector3Stream::PaddedCount() const -> int
+{
+	return _x.PaddedCount();
+}
+
+auto Vector3Stream::GetX() -> float*
+{
+	return _x.Data();
+}
+
+auto Vector3Stream::GetX() const -> const float*
+{
+	return _x.Data();
+}
+
+auto Vector3Stream::GetY() -> float*
+{
+	return _y.Data();
+}
+
+auto Vector3Stream::GetY() const -> const float*
+{
+	return _y.Data();
+}
+
+auto Vector3Stream::GetZ() -> float*
+{
+	return _z.Data();
+}
+
+auto Vector3Stream::GetZ() const -> const float*
+{
+	return _z.Data();
+}
+
+auto Vector3Stream::Item(int index) -> Reference
+{
+	return { _x.Item(index), _y.Item(index), _z.Item(index) };
+}
+
+auto Vector3Stream::Item(int index) const -> Vector3
+{
+	return { _x.Item(index), _y.Item(index), _z.Item(index) };
+}
+
+void Vector3Stream::SetCount(int count)
+{
+	_x.SetCount(count);
+	_y.SetCount(count);
+	_z.SetCount(count);
+}
+
+void Vector3Stream::Add(Vector3 vector)
+{
+	_x.Add(vector.X);
+	_y.Add(vector.Y);
+	_z.Add(vector.Z);
+}
+
+void Vector3Stream::CopyFrom(const Vector3* vectors, int count)
+{
+	SetCount(count);
+	Deinterleave3(&vectors->X, count, _x.Data(), _y.Data(), _z.Data());
+}
+
+void Vector3Stream::CopyTo(Vector3* vectors) const
+{
+	Interleave3(_x.Data(), _y.Data(), _z.Data(), Count(), &vectors->X);
+}
+
+Point3Stream::Reference::operator Point3() const
+{
+	return { X, Y, Z };
+}
+
+auto Point3Stream::Reference::operator=(Point3 point) -> Reference&
+{
+	X = point.X;
+	Y = point.Y;
+	Z = point.Z;
+	return *this;
+}
+
+auto Point3Stream::Reference::operator=(const Reference& reference) -> Reference&
+{
+	return operator=(static_cast<Point3>(reference));
+}
+
+Point3Stream::Point3Stream(int count)
+{
+	SetCount(count);
+}
+
+Point3Stream::Point3Stream(const Point3* points, int count)
+{
+	CopyFrom(points, count);
+}
+
+auto Point3Stream::Count() const -> int
+{
+	return _x.Count();
+}
+
+auto Point3Stream::PaddedCount() const -> int
+{
+	return _x.PaddedCount();
+}
+
+auto Point3Stream::GetX() -> float*
+{
+	return _x.Data();
+}
+
+auto Point3Stream::GetX() const -> const float*
+{
+	return _x.Data();
+}
+
+auto Point3Stream::GetY() -> float*
+{
+	return _y.Data();
+}
+
+auto Point3Stream::GetY() const -> const float*
+{
+	return _y.Data();
+}
+
+auto Point3Stream::GetZ() -> float*
+{
+	return _z.Data();
+}
+
+auto Point3Stream::GetZ() const -> const float*
+{
+	return _z.Data();
+}
+
+auto Point3Stream::Item(int index) -> Reference
+{
+	return { _x.Item(index), _y.Item(index), _z.Item(index) };
+}
+
+auto Point3Stream::Item(int index) const -> Point3
+{
+	return { _x.Item(index), _y.Item(index), _z.Item(index) };
+}
+
+void Point3Stream::SetCount(int count)
+{
+	_x.SetCount(count);
+	_y.SetCount(count);
+	_z.SetCount(count);
+}
+
+void Point3Stream::Add(Point3 point)
+{
+	_x.Add(point.X);
+	_y.Add(point.Y);
+	_z.Add(point.Z);
+}
+
+void Point3Stream::CopyFrom(const Point3* points, int count)
+{
+	SetCount(count);
+	Deinterleave3(&points->X, count, _x.Data(), _y.Data(), _z.Data());
+}
+
+void Point3Stream::CopyTo(Point3* points) const
+{
+	Interleave3(_x.Data(), _y.Data(), _z.Data(), Count(), &points->X);
+}
+
+QuaternionStream::Reference::operator Quaternion() const
+{
+	return { X, Y, Z, W };
+}
+
+auto QuaternionStream::Reference::operator=(Quaternion quaternion) -> Reference&
+{
+	X = quaternion.X;
+	Y = quaternion.Y;
+	Z = quaternion.Z;
+	W = quaternion.W;
+	return *this;
+}
+
+auto QuaternionStream::Reference::operator=(const Reference& reference) -> Reference&
+{
+	return operator=(static_cast<Quaternion>(reference));
+}
+
+QuaternionStream::QuaternionStream(int count)
+{
+	SetCount(count);
+}
+
+QuaternionStream::QuaternionStream(const Quaternion* quaternions, int count)
+{
+	CopyFrom(quaternions, count);
+}
+
+auto QuaternionStream::Count() const -> int
+{
+	return _x.Count();
+}
+
+auto QuaternionStream::PaddedCount() const -> int
+{
+	return _x.PaddedCount();
+}
+
+auto QuaternionStream::GetX() -> float*
+{
+	return _x.Data();
+}
+
+auto QuaternionStream::GetX() const -> const float*
+{
+	return _x.Data();
+}
+
+auto QuaternionStream::GetY() -> float*
+{
+	return _y.Data();
+}
+
+auto QuaternionStream::GetY() const -> const float*
+{
+	return _y.Data();
+}
+
+auto QuaternionStream::GetZ() -> float*
+{
+	return _z.Data();
+}
+
+auto QuaternionStream::GetZ() const -> const float*
+{
+	return _z.Data();
+}
+
+auto QuaternionStream::GetW() -> float*
+{
+	return _w.Data();
+}
+
+auto QuaternionStream::GetW() const -> const float*
+{
+	return _w.Data();
+}
+
+auto QuaternionStream::Item(int index) -> Reference
+{
+	return { _x.Item(index), _y.Item(index), _z.Item(index), _w.Item(index) };
+}
+
+auto QuaternionStream::Item(int index) const -> Quaternion
+{
+	return { _x.Item(index), _y.Item(index), _z.Item(index), _w.Item(index) };
+}
+
+void QuaternionStream::SetCount(int count)
+{
+	_x.SetCount(count);
+	_y.SetCount(count);
+	_z.SetCount(count);
+	_w.SetCount(count);
+}
+
+void QuaternionStream::Add(Quaternion quaternion)
+{
+	_x.Add(quaternion.X);
+	_y.Add(quaternion.Y);
+	_z.Add(quaternion.Z);
+	_w.Add(quaternion.W);
+}
+
+void QuaternionStream::CopyFrom(const Quaternion* quaternions, int count)
+{
+	SetCount(count);
+	Deinterleave4(&quaternions->X, count, _x.Data(), _y.Data(), _z.Data(), _w.Data());
+}
+
+void QuaternionStream::CopyTo(Quaternion* quaternions) const
+{
+	Interleave4(_x.Data(), _y.Data(), _z.Data(), _w.Data(), Count(), &quaternions->X);
+}
@@ -0,0 +1,524 @@
+#include "Pargon/Math/SweepAndPrune.h"
+#include "Core/Simd.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+using namespace Pargon;
+
+namespace
+{
+	constexpr std::uint64_t _emptySlot = ~0ull;
+	constexpr std::size_t _minimumPairSlots = 64;
+	constexpr std::size_t _sweepCandidateCount = 4096;
+
+	enum class BodyState : std::uint8_t
+	{
+		Free,
+		Inserted,
+		Active,
+		Removed
+	};
+
+	// Data holds the body shifted up by one with the low bit set for a maximum.
+	struct Endpoint
+	{
+		float Value;
+		std::uint32_t Data;
+	};
+
+	auto IsValid(const Aabb3& bounds) -> bool
+	{
+		return bounds.Minimum.X <= bounds.Maximum.X && bounds.Minimum.Y <= bounds.Maximum.Y && bounds.Minimum.Z <= bounds.Maximum.Z;
+	}
+
+	auto GetValue(const Aabb3& bounds, int axis, bool maximum) -> float
+	{
+		auto point = maximum ? bounds.Maximum : bounds.Minimum;
+		return axis == 0 ? point.X : (axis == 1 ? point.Y : point.Z);
+	}
+
+	auto GetKey(int first, int second) -> std::uint64_t
+	{
+		return (static_cast<std::uint64_t>(std::min(first, second)) << 32) | static_cast<std::uint32_t>(std::max(first, second));
+	}
+
+	auto GetPair(std::uint64_t key) -> SweepAndPrune::Pair
+	{
+		return { static_cast<int>(key >> 32), static_cast<int>(key & 0xFFFFFFFFu) };
+	}
+
+	auto GetHome(std::uint64_t key, std::size_t mask) -> std::size_t
+	{
+		return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+	}
+
+	// At equal values minimums sort before maximums so bounds that touch are ordered the same as bounds that overlap.
+
+	auto IsBefore(const Endpoint& left, const Endpoint& right) -> bool
+	{
+		return left.Value < right.Value || (left.Value == right.Value && (left.Data & 1u) < (right.Data & 1u));
+	}
+
+	template<typename Report>
+	void TestPairs(const Aabb3* bounds, const SweepAndPrune::Pair* pairs, int count, Report report)
+	{
+		constexpr auto width = Simd::Wide::Width;
+
+		// Each group of pairs is gathered into lanes so every axis of the group is compared at once. The last group is
+		// padded by repeating its final pair.
+
+		for (auto start = 0; start < count; start += width)
+		{
+			alignas(32) float values[12][width];
+
+			for (auto lane = 0; lane < width; lane++)
+			{
+				auto& pair = pairs[std::min(start + lane, count - 1)];
+				auto& first = bounds[pair.First];
+				auto& second = bounds[pair.Second];
+
+				values[0][lane] = first.Minimum.X;
+				values[1][lane] = first.Minimum.Y;
+				values[2][lane] = first.Minimum.Z;
+				values[3][lane] = first.Maximum.X;
+				values[4][lane] = first.Maximum.Y;
+				values[5][lane] = first.Maximum.Z;
+				values[6][lane] = second.Minimum.X;
+				values[7][lane] = second.Minimum.Y;
+				values[8][lane] = second.Minimum.Z;
+				values[9][lane] = second.Maximum.X;
+				values[10][lane] = second.Maximum.Y;
+				values[11][lane] = second.Maximum.Z;
+			}
+
+			auto overlapX = Simd::LessThanOrEqual(Simd::Wide::Load(values[0]), Simd::Wide::Load(values[9])) & Simd::LessThanOrEqual(Simd::Wide::Load(values[6]), Simd::Wide::Load(values[3]));
+			auto overlapY = Simd::LessThanOrEqual(Simd::Wide::Load(values[1]), Simd::Wide::Load(values[10])) & Simd::LessThanOrEqual(Simd::Wide::Load(values[7]), Simd::Wide::Load(values[4]));
+			auto overlapZ = Simd::LessThanOrEqual(Simd::Wide::Load(values[2]), Simd::Wide::Load(values[11])) & Simd::LessThanOrEqual(Simd::Wide::Load(values[8]), Simd::Wide::Load(values[5]));
+			auto mask = Simd::MoveMask(overlapX & overlapY & overlapZ);
+			auto end = std::min(start + width, count);
+
+			for (auto index = start; index < end; index++)
+				report(pairs[index], ((mask >> (index - start)) & 1) != 0);
+		}
+	}
+}
+
+struct SweepAndPrune::Data
+{
+	std::vector<Aabb3> Bounds;
+	std::vector<BodyState> States;
+	std::vector<int> FreeBodies;
+	std::vector<int> InsertedBodies;
+	std::vector<int> RemovedBodies;
+
+	std::vector<Endpoint> Endpoints[3];
+	std::vector<Endpoint> InsertedEndpoints;
+
+	std::vector<std::uint64_t> PairSlots;
+	int PairCount = 0;
+
+	std::vector<Pair> AddedPairs;
+	std::vector<Pair> RemovedPairs;
+	std::vector<Pair> Pairs;
+	std::vector<Pair> Candidates;
+	std::vector<int> Active;
+	std::vector<int> ActiveInserted;
+	std::vector<int> ActiveSlots;
+
+	void GetPairs(Pair* pairs) const;
+	void SortAxis(int axis);
+	void InsertBodies(int axis);
+	void SweepInsertedBodies();
+	void RemovePairs();
+	void AddPairs();
+
+	auto FindPair(std::uint64_t key) const -> int;
+	void AddPair(std::uint64_t key);
+	void RemovePair(std::uint64_t key);
+	void GrowPairs();
+};
+
+SweepAndPrune::SweepAndPrune() :
+	_data(std::make_unique<Data>())
+{
+}
+
+SweepAndPrune::SweepAndPrune(const SweepAndPrune& copy) :
+	_data(std::make_unique<Data>(*copy._data)),
+	_count(copy._count)
+{
+}
+
+SweepAndPrune::SweepAndPrune(SweepAndPrune&& move) noexcept = default;
+SweepAndPrune::~SweepAndPrune() = default;
+
+auto SweepAndPrune::operator=(const SweepAndPrune& copy) -> SweepAndPrune&
+{
+	if (!_data)
+		_data = std::make_unique<Data>(*copy._data);
+	else if (this != &copy)
+		*_data = *copy._data;
+
+	_count = copy._count;
+	return *this;
+}
+
+auto SweepAndPrune::operator=(SweepAndPrune&& move) noexcept -> SweepAndPrune&
+{
+	std::swap(_data, move._data);
+	std::swap(_count, move._count);
+	return *this;
+}
+
+auto SweepAndPrune::Insert(const Aabb3& bounds) -> int
+{
+	assert(IsValid(bounds));
+
+	auto body = static_cast<int>(_data->Bounds.size());
+
+	if (_data->FreeBodies.empty())
+	{
+		_data->Bounds.push_back(bounds);
+		_data->States.push_back(BodyState::Inserted);
+	}
+	else
+	{
+		body = _data->FreeBodies.back();
+		_data->FreeBodies.pop_back();
+		_data->Bounds[body] = bounds;
+		_data->States[body] = BodyState::Inserted;
+	}
+
+	_data->InsertedBodies.push_back(body);
+	_count++;
+	return body;
+}
+
+void SweepAndPrune::Move(int body, const Aabb3& bounds)
+{
+	assert(body >= 0 && body < static_cast<int>(_data->Bounds.size()));
+	assert(_data->States[body] == BodyState::Inserted || _data->States[body] == BodyState::Active);
+	assert(IsValid(bounds));
+
+	_data->Bounds[body] = bounds;
+}
+
+void SweepAndPrune::Remove(int body)
+{
+	assert(body >= 0 && body < static_cast<int>(_data->Bounds.size()));
+	assert(_data->States[body] == BodyState::Inserted || _data->States[body] == BodyState::Active);
+
+	_data->States[body] = BodyState::Removed;
+	_data->RemovedBodies.push_back(body);
+	_count--;
+}
+
+void SweepAndPrune::Update()
+{
+	_data->AddedPairs.clear();
+	_data->RemovedPairs.clear();
+
+	for (auto axis = 0; axis < 3; axis++)
+		_data->SortAxis(axis);
+
+	_data->RemovePairs();
+	_data->AddPairs();
+
+	if (!_data->InsertedBodies.empty())
+	{
+		for (auto axis = 0; axis < 3; axis++)
+			_data->InsertBodies(axis);
+
+		_data->SweepInsertedBodies();
+	}
+
+	for (auto body : _data->InsertedBodies)
+	{
+		if (_data->States[body] == BodyState::Inserted)
+			_data->States[body] = BodyState::Active;
+	}
+
+	for (auto body : _data->RemovedBodies)
+	{
+		_data->States[body] = BodyState::Free;
+		_data->FreeBodies.push_back(body);
+	}
+
+	_data->InsertedBodies.clear();
+	_data->RemovedBodies.clear();
+}
+
+auto SweepAndPrune::Count() const -> int
+{
+	return _count;
+}
+
+auto SweepAndPrune::GetBounds(int body) const -> const Aabb3&
+{
+	assert(body >= 0 && body < static_cast<int>(_data->Bounds.size()));
+	assert(_data->States[body] != BodyState::Free);
+
+	return _data->Bounds[body];
+}
+
+auto SweepAndPrune::GetPairCount() const -> int
+{
+	return _data->PairCount;
+}
+
+auto SweepAndPrune::HasPair(int first, int second) const -> bool
+{
+	return first != second && _data->FindPair(GetKey(first, second)) >= 0;
+}
+
+void SweepAndPrune::GetPairs(Pair* pairs) const
+{
+	_data->GetPairs(pairs);
+}
+
+auto SweepAndPrune::GetAddedPairCount() const -> int
+{
+	return static_cast<int>(_data->AddedPairs.size());
+}
+
+auto SweepAndPrune::GetAddedPairs() const -> const Pair*
+{
+	return _data->AddedPairs.data();
+}
+
+auto SweepAndPrune::GetRemovedPairCount() const -> int
+{
+	return static_cast<int>(_data->RemovedPairs.size());
+}
+
+auto SweepAndPrune::GetRemovedPairs() const -> const Pair*
+{
+	return _data->RemovedPairs.data();
+}
+
+void SweepAndPrune::Data::GetPairs(Pair* pairs) const
+{
+	for (auto key : PairSlots)
+	{
+		if (key != _emptySlot)
+			*pairs++ = GetPair(key);
+	}
+}
+
+void SweepAndPrune::Data::SortAxis(int axis)
+{
+	auto& endpoints = Endpoints[axis];
+	auto count = 0;
+
+	for (auto& endpoint : endpoints)
+	{
+		auto body = static_cast<int>(endpoint.Data >> 1);
+
+		if (States[body] != BodyState::Removed)
+			endpoints[count++] = { GetValue(Bounds[body], axis, (endpoint.Data & 1u) != 0), endpoint.Data };
+	}
+
+	endpoints.resize(count);
+
+	// The endpoints are still in their order from the last Update, so each one only moves past the endpoints it
+	// crossed since then. A pair can only start overlapping when the minimum of one moves before the maximum of the
+	// other along some axis.
+
+	for (auto index = 1; index < count; index++)
+	{
+		auto endpoint = endpoints[index];
+		auto position = index;
+
+		for (; position > 0 && IsBefore(endpoint, endpoints[position - 1]); position--)
+		{
+			auto other = endpoints[position - 1];
+
+			if ((other.Data & ~endpoint.Data) & 1u)
+			{
+				auto first = static_cast<int>(endpoint.Data >> 1);
+				auto second = static_cast<int>(other.Data >> 1);
+				Candidates.push_back({ std::min(first, second), std::max(first, second) });
+			}
+
+			endpoints[position] = other;
+		}
+
+		endpoints[position] = endpoint;
+	}
+}
+
+void SweepAndPrune::Data::InsertBodies(int axis)
+{
+	InsertedEndpoints.clear();
+
+	for (auto body : InsertedBodies)
+	{
+		if (States[body] == BodyState::Inserted)
+		{
+			InsertedEndpoints.push_back({ GetValue(Bounds[body], axis, false), static_cast<std::uint32_t>(body) << 1 });
+			InsertedEndpoints.push_back({ GetValue(Bounds[body], axis, true), (static_cast<std::uint32_t>(body) << 1) | 1u });
+		}
+	}
+
+	auto& endpoints = Endpoints[axis];
+	auto middle = endpoints.size();
+
+	std::sort(InsertedEndpoints.begin(), InsertedEndpoints.end(), IsBefore);
+	endpoints.insert(endpoints.end(), InsertedEndpoints.begin(), InsertedEndpoints.end());
+	std::inplace_merge(endpoints.begin(), endpoints.begin() + middle, endpoints.end(), IsBefore);
+}
+
+void SweepAndPrune::Data::SweepInsertedBodies()
+{
+	// Bodies overlap along the first axis exactly when the minimum of one is reached while the other is open, so a
+	// sweep that keeps the open bodies finds every pair with an inserted body once.
+
+	Active.clear();
+	ActiveInserted.clear();
+	ActiveSlots.resize(Bounds.size());
+
+	for (auto& endpoint : Endpoints[0])
+	{
+		auto body = static_cast<int>(endpoint.Data >> 1);
+		auto inserted = States[body] == BodyState::Inserted;
+		auto& active = inserted ? ActiveInserted : Active;
+
+		if (endpoint.Data & 1u)
+		{
+			auto slot = ActiveSlots[body];
+			active[slot] = active.back();
+			ActiveSlots[active[slot]] = slot;
+			active.pop_back();
+		}
+		else
+		{
+			for (auto other : ActiveInserted)
+				Candidates.push_back({ std::min(body, other), std::max(body, other) });
+
+			if (inserted)
+			{
+				for (auto other : Active)
+					Candidates.push_back({ std::min(body, other), std::max(body, other) });
+			}
+
+			ActiveSlots[body] = static_cast<int>(active.size());
+			active.push_back(body);
+
+			if (Candidates.size() >= _sweepCandidateCount)
+				AddPairs();
+		}
+	}
+
+	AddPairs();
+}
+
+void SweepAndPrune::Data::RemovePairs()
+{
+	// Every pair is tested again rather than tracking the endpoints that separate, since there are usually far fewer
+	// pairs than separating swaps.
+
+	Pairs.resize(PairCount);
+	GetPairs(Pairs.data());
+
+	TestPairs(Bounds.data(), Pairs.data(), static_cast<int>(Pairs.size()), [this](const Pair& pair, bool overlaps)
+	{
+		if (!overlaps || States[pair.First] == BodyState::Removed || States[pair.Second] == BodyState::Removed)
+		{
+			RemovePair(GetKey(pair.First, pair.Second));
+			RemovedPairs.push_back(pair);
+		}
+	});
+}
+
+void SweepAndPrune::Data::AddPairs()
+{
+	// A pair can be found on more than one axis, so it is looked up before being added.
+
+	TestPairs(Bounds.data(), Candidates.data(), static_cast<int>(Candidates.size()), [this](const Pair& pair, bool overlaps)
+	{
+		auto key = GetKey(pair.First, pair.Second);
+
+		if (overlaps && FindPair(key) < 0)
+		{
+			AddPair(key);
+			AddedPairs.push_back(pair);
+		}
+	});
+
+	Candidates.clear();
+}
+
+auto SweepAndPrune::Data::FindPair(std::uint64_t key) const -> int
+{
+	if (PairSlots.empty())
+		return -1;
+
+	auto mask = PairSlots.size() - 1;
+
+	for (auto slot = GetHome(key, mask); ; slot = (slot + 1) & mask)
+	{
+		if (PairSlots[slot] == key)
+			return static_cast<int>(slot);
+
+		if (PairSlots[slot] == _emptySlot)
+			return -1;
+	}
+}
+
+void SweepAndPrune::Data::AddPair(std::uint64_t key)
+{
+	if (static_cast<std::size_t>(PairCount + 1) * 2 > PairSlots.size())
+		GrowPairs();
+
+	auto mask = PairSlots.size() - 1;
+	auto slot = GetHome(key, mask);
+
+	while (PairSlots[slot] != _emptySlot)
+		slot = (slot + 1) & mask;
+
+	PairSlots[slot] = key;
+	PairCount++;
+}
+
+void SweepAndPrune::Data::RemovePair(std::uint64_t key)
+{
+	auto slot = FindPair(key);
+	assert(slot >= 0);
+
+	// Later pairs in the same run move back into the hole unless their home is past it, so a lookup never stops at
+	// the hole before reaching them.
+
+	auto mask = PairSlots.size() - 1;
+	auto hole = static_cast<std::size_t>(slot);
+
+	for (auto next = (hole + 1) & mask; PairSlots[next] != _emptySlot; next = (next + 1) & mask)
+	{
+		auto home = GetHome(PairSlots[next], mask);
+
+		if (((next - home) & mask) >= ((next - hole) & mask))
+		{
+			PairSlots[hole] = PairSlots[next];
+			hole = next;
+		}
+	}
+
+	PairSlots[hole] = _emptySlot;
+	PairCount--;
+}
+
+void SweepAndPrune::Data::GrowPairs()
+{
+	auto slots = std::move(PairSlots);
+
+	PairSlots.assign(std::max(slots.size() * 2, _minimumPairSlots), _emptySlot);
+	PairCount = 0;
+
+	for (auto key : slots)
+	{
+		if (key != _emptySlot)
+			AddPair(key);
+	}
+}
@@ -1,38 +1,376 @@
 #include "Pargon/Math/Angle.h"
 #include "Pargon/Math/Trigonometry.h"
+#include "Core/Simd.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cml/cml.h>
 
-auto Pargon::Sine(Rotation rotation) -> float
+using namespace Pargon;
+
+namespace
+{
+	static_assert(sizeof(Rotation) == sizeof(float), "Rotation arrays are read as packed radians");
+
+	constexpr float _pi = 3.14159265358979324f;
+	constexpr float _piOver2 = 1.57079632679489662f;
+	constexpr float _tanPiOver8 = 0.414213562373095049f;
+	constexpr float _twoOverPi = 0.636619772367581343f;
+	constexpr float _piOver2High = 1.5703125f;
+	constexpr float _piOver2Middle = 4.837512969970703125e-4f;
+	constexpr float _piOver2Low = 7.549533620476723e-8f;
+	constexpr float _piOver2Lowest = 2.5633440682570896e-12f;
+
+	// Beyond this the quadrant has more bits than the split constants leave room for, so the reduction is no longer
+	// exact without a fused multiply add and lanes are handed to the standard library instead.
+	constexpr float _fastReductionLimit = 8192.0f;
+
+	void SineCosineLanes(Simd::Wide radians, Simd::Wide& sine, Simd::Wide& cosine)
+	{
+		auto half = Simd::Wide::Broadcast(0.5f);
+		auto quarter = Simd::Wide::Broadcast(0.25f);
+		auto negativeQuarter = Simd::Wide::Broadcast(-0.25f);
+		auto two = Simd::Wide::Broadcast(2.0f);
+
+		auto quadrant = Simd::Round(radians * Simd::Wide::Broadcast(_twoOverPi));
+		auto reduced = Simd::MultiplyAdd(quadrant, Simd::Wide::Broadcast(-_piOver2High), radians);
+		reduced = Simd::MultiplyAdd(quadrant, Simd::Wide::Broadcast(-_piOver2Middle), reduced);
+		reduced = Simd::MultiplyAdd(quadrant, Simd::Wide::Broadcast(-_piOver2Low), reduced);
+		reduced = Simd::MultiplyAdd(quadrant, Simd::Wide::Broadcast(-_piOver2Lowest), reduced);
+
+		auto squared = reduced * reduced;
+
+		auto sinePolynomial = Simd::MultiplyAdd(squared, Simd::Wide::Broadcast(-1.9515295891e-4f), Simd::Wide::Broadcast(8.3321608736e-3f));
+		sinePolynomial = Simd::MultiplyAdd(squared, sinePolynomial, Simd::Wide::Broadcast(-1.6666654611e-1f));
+		sinePolynomial = Simd::MultiplyAdd(squared * reduced, sinePolynomial, reduced);
+
+		auto cosinePolynomial = Simd::MultiplyAdd(squared, Simd::Wide::Broadcast(2.443315711809948e-5f), Simd::Wide::Broadcast(-1.388731625493765e-3f));
+		cosinePolynomial = Simd::MultiplyAdd(squared, cosinePolynomial, Simd::Wide::Broadcast(4.166664568298827e-2f));
+		cosinePolynomial = Simd::MultiplyAdd(squared * squared, cosinePolynomial, Simd::MultiplyAdd(squared, Simd::Wide::Broadcast(-0.5f), Simd::Wide::Broadcast(1.0f)));
+
+		auto halfQuadrant = Simd::Round(Simd::MultiplyAdd(quadrant, half, negativeQuarter));
+		auto swap = Simd::GreaterThan(quadrant - two * halfQuadrant, half);
+		auto sineNegate = Simd::GreaterThan(halfQuadrant - two * Simd::Round(Simd::MultiplyAdd(halfQuadrant, half, negativeQuarter)), half);
+
+		auto cosineHalfQuadrant = Simd::Round(Simd::MultiplyAdd(quadrant, half, quarter));
+		auto cosineNegate = Simd::GreaterThan(cosineHalfQuadrant - two * Simd::Round(Simd::MultiplyAdd(cosineHalfQuadrant, half, negativeQuarter)), half);
+
+		sine = Simd::Select(swap, cosinePolynomial, sinePolynomial) ^ (sineNegate & Simd::SignMask());
+		cosine = Simd::Select(swap, sinePolynomial, cosinePolynomial) ^ (cosineNegate & Simd::SignMask());
+
+		auto large = Simd::MoveMask(Simd::GreaterThan(Simd::AbsoluteValue(radians), Simd::Wide::Broadcast(_fastReductionLimit)));
+
+		if (large != 0)
+		{
+			float values[Simd::Wide::Width], sines[Simd::Wide::Width], cosines[Simd::Wide::Width];
+			radians.StoreUnaligned(values);
+			sine.StoreUnaligned(sines);
+			cosine.StoreUnaligned(cosines);
+
+			for (auto lane = 0; lane < Simd::Wide::Width; lane++)
+			{
+				if (large & (1 << lane))
+				{
+					sines[lane] = std::sin(values[lane]);
+					cosines[lane] = std::cos(values[lane]);
+				}
+			}
+
+			sine = Simd::Wide::LoadUnaligned(sines);
+			cosine = Simd::Wide::LoadUnaligned(cosines);
+		}
+	}
+
+	void ArcSineLanes(Simd::Wide value, Simd::Wide& arcSine, Simd::Wide& arcCosine)
+	{
+		auto one = Simd::Wide::Broadcast(1.0f);
+		auto half = Simd::Wide::Broadcast(0.5f);
+		auto two = Simd::Wide::Broadcast(2.0f);
+		auto piOver2 = Simd::Wide::Broadcast(_piOver2);
+
+		auto magnitude = Simd::Minimum(Simd::AbsoluteValue(value), one);
+		auto negative = value & Simd::SignMask();
+		auto large = Simd::GreaterThan(magnitude, half);
+
+		auto squared = Simd::Select(large, half * (one - magnitude), magnitude * magnitude);
+		auto reduced = Simd::Select(large, Simd::SquareRoot(squared), magnitude);
+
+		auto polynomial = Simd::MultiplyAdd(squared, Simd::Wide::Broadcast(4.2163199048e-2f), Simd::Wide::Broadcast(2.4181311049e-2f));
+		polynomial = Simd::MultiplyAdd(squared, polynomial, Simd::Wide::Broadcast(4.5470025998e-2f));
+		polynomial = Simd::MultiplyAdd(squared, polynomial, Simd::Wide::Broadcast(7.4953002686e-2f));
+		polynomial = Simd::MultiplyAdd(squared, polynomial, Simd::Wide::Broadcast(1.6666752422e-1f));
+		polynomial = Simd::MultiplyAdd(squared * reduced, polynomial, reduced);
+
+		arcSine = Simd::Select(large, piOver2 - two * polynomial, polynomial) | negative;
+
+		auto largeCosine = two * polynomial;
+		largeCosine = Simd::Select(Simd::LessThan(value, Simd::Wide::Broadcast(0.0f)), Simd::Wide::Broadcast(_pi) - largeCosine, largeCosine);
+		arcCosine = Simd::Select(large, largeCosine, piOver2 - (polynomial | negative));
+	}
+
+	auto ArcTangentLanes(Simd::Wide x, Simd::Wide y) -> Simd::Wide
+	{
+		auto zero = Simd::Wide::Broadcast(0.0f);
+		auto one = Simd::Wide::Broadcast(1.0f);
+
+		auto absoluteX = Simd::AbsoluteValue(x);
+		auto absoluteY = Simd::AbsoluteValue(y);
+		auto largest = Simd::Maximum(absoluteX, absoluteY);
+		auto ratio = Simd::Minimum(absoluteX, absoluteY) / Simd::Select(Simd::GreaterThan(largest, zero), largest, one);
+
+		auto shifted = Simd::GreaterThan(ratio, Simd::Wide::Broadcast(_tanPiOver8));
+		ratio = Simd::Select(shifted, (ratio - one) / (ratio + one), ratio);
+
+		auto squared = ratio * ratio;
+		auto polynomial = Simd::MultiplyAdd(squared, Simd::Wide::Broadcast(8.05374449538e-2f), Simd::Wide::Broadcast(-1.38776856032e-1f));
+		polynomial = Simd::MultiplyAdd(squared, polynomial, Simd::Wide::Broadcast(1.99777106478e-1f));
+		polynomial = Simd::MultiplyAdd(squared, polynomial, Simd::Wide::Broadcast(-3.33329491539e-1f));
+		polynomial = Simd::MultiplyAdd(squared * ratio, polynomial, ratio);
+
+		auto result = polynomial + (shifted & Simd::Wide::Broadcast(_pi * 0.25f));
+		result = Simd::Select(Simd::GreaterThan(absoluteY, absoluteX), Simd::Wide::Broadcast(_piOver2) - result, result);
+		result = Simd::Select(Simd::LessThan(x, zero), Simd::Wide::Broadcast(_pi) - result, result);
+
+		return Simd::CopySign(result, y);
+	}
+
+	auto FirstLane(Simd::Wide value) -> float
+	{
+		float values[Simd::Wide::Width];
+		value.StoreUnaligned(values);
+		return values[0];
+	}
+
+	void StoreLanes(Simd::Wide value, float* results, int lanes)
+	{
+		if (lanes == Simd::Wide::Width)
+		{
+			value.StoreUnaligned(results);
+		}
+		else
+		{
+			float values[Simd::Wide::Width];
+			value.StoreUnaligned(values);
+			std::copy(values, values + lanes, results);
+		}
+	}
+
+	auto LoadLanes(const float* values, int lanes) -> Simd::Wide
+	{
+		if (lanes == Simd::Wide::Width)
+			return Simd::Wide::LoadUnaligned(values);
+
+		float block[Simd::Wide::Width] = {};
+		std::copy(values, values + lanes, block);
+		return Simd::Wide::LoadUnaligned(block);
+	}
+
+	template <typename Function>
+	void ForEachBlock(int count, Function&& function)
+	{
+		for (auto index = 0; index < count; index += Simd::Wide::Width)
+			function(index, std::min(count - index, Simd::Wide::Width));
+	}
+}
+
+auto Pargon::Sine(Rotation rotation, TrigonometryPrecision precision) -> float
 {
+	if (precision == TrigonometryPrecision::Fast)
+		return SineCosine(rotation, precision).Sine;
+
 	return std::sin(rotation.InRadians());
 }
 
-auto Pargon::Cosine(Rotation rotation) -> float
+auto Pargon::Cosine(Rotation rotation, TrigonometryPrecision precision) -> float
 {
+	if (precision == TrigonometryPrecision::Fast)
+		return SineCosine(rotation, precision).Cosine;
+
 	return std::cos(rotation.InRadians());
 }
 
-auto Pargon::Tangent(Rotation rotation) -> float
+auto Pargon::Tangent(Rotation rotation, TrigonometryPrecision precision) -> float
 {
+	if (precision == TrigonometryPrecision::Fast)
+	{
+		auto result = SineCosine(rotation, precision);
+		return result.Sine / result.Cosine;
+	}
+
 	return std::tan(rotation.InRadians());
 }
 
-auto Pargon::ArcSine(float value) -> Rotation
+auto Pargon::SineCosine(Rotation rotation, TrigonometryPrecision precision) -> SineAndCosine
+{
+	if (precision == TrigonometryPrecision::Fast)
+	{
+		Simd::Wide sine, cosine;
+		SineCosineLanes(Simd::Wide::Broadcast(rotation.InRadians()), sine, cosine);
+		return { FirstLane(sine), FirstLane(cosine) };
+	}
+
+	return { std::sin(rotation.InRadians()), std::cos(rotation.InRadians()) };
+}
+
+void Pargon::Sine(const Rotation* rotations, int count, float* results, TrigonometryPrecision precision)
+{
+	if (precision == TrigonometryPrecision::Precise)
+	{
+		for (auto i = 0; i < count; i++)
+			results[i] = std::sin(rotations[i].InRadians());
+
+		return;
+	}
+
+	ForEachBlock(count, [rotations, results](int index, int lanes)
+	{
+		Simd::Wide sine, cosine;
+		SineCosineLanes(LoadLanes(reinterpret_cast<const float*>(rotations) + index, lanes), sine, cosine);
+		StoreLanes(sine, results + index, lanes);
+	});
+}
+
+void Pargon::Cosine(const Rotation* rotations, int count, float* results, TrigonometryPrecision precision)
+{
+	if (precision == TrigonometryPrecision::Precise)
+	{
+		for (auto i = 0; i < count; i++)
+			results[i] = std::cos(rotations[i].InRadians());
+
+		return;
+	}
+
+	ForEachBlock(count, [rotations, results](int index, int lanes)
+	{
+		Simd::Wide sine, cosine;
+		SineCosineLanes(LoadLanes(reinterpret_cast<const float*>(rotations) + index, lanes), sine, cosine);
+		StoreLanes(cosine, results + index, lanes);
+	});
+}
+
+void Pargon::Tangent(const Rotation* rotations, int count, float* results, TrigonometryPrecision precision)
+{
+	if (precision == TrigonometryPrecision::Precise)
+	{
+		for (auto i = 0; i < count; i++)
+			results[i] = std::tan(rotations[i].InRadians());
+
+		return;
+	}
+
+	ForEachBlock(count, [rotations, results](int index, int lanes)
+	{
+		Simd::Wide sine, cosine;
+		SineCosineLanes(LoadLanes(reinterpret_cast<const float*>(rotations) + index, lanes), sine, cosine);
+		StoreLanes(sine / cosine, results + index, lanes);
+	});
+}
+
+void Pargon::SineCosine(const Rotation* rotations, int count, float* sines, float* cosines, TrigonometryPrecision precision)
+{
+	if (precision == TrigonometryPrecision::Precise)
+	{
+		for (auto i = 0; i < count; i++)
+		{
+			sines[i] = std::sin(rotations[i].InRadians());
+			cosines[i] = std::cos(rotations[i].InRadians());
+		}
+
+		return;
+	}
+
+	ForEachBlock(count, [rotations, sines, cosines](int index, int lanes)
+	{
+		Simd::Wide sine, cosine;
+		SineCosineLanes(LoadLanes(reinterpret_cast<const float*>(rotations) + index, lanes), sine, cosine);
+		StoreLanes(sine, sines + index, lanes);
+		StoreLanes(cosine, cosines + index, lanes);
+	});
+}
+
+auto Pargon::ArcSine(float value, TrigonometryPrecision precision) -> Rotation
 {
+	if (precision == TrigonometryPrecision::Fast)
+	{
+		Simd::Wide arcSine, arcCosine;
+		ArcSineLanes(Simd::Wide::Broadcast(value), arcSine, arcCosine);
+		return Rotation::FromRadians(FirstLane(arcSine));
+	}
+
 	return Rotation::FromRadians(cml::asin_safe(value));
 }
 
-auto Pargon::ArcCosine(float value) -> Rotation
+auto Pargon::ArcCosine(float value, TrigonometryPrecision precision) -> Rotation
 {
+	if (precision == TrigonometryPrecision::Fast)
+	{
+		Simd::Wide arcSine, arcCosine;
+		ArcSineLanes(Simd::Wide::Broadcast(value), arcSine, arcCosine);
+		return Rotation::FromRadians(FirstLane(arcCosine));
+	}
+
 	return Rotation::FromRadians(cml::acos_safe(value));
 }
 
-auto Pargon::ArcTangent(float x, float y) -> Rotation
+auto Pargon::ArcTangent(float x, float y, TrigonometryPrecision precision) -> Rotation
 {
 	if (x == 0.0f && y == 0.0f)
 		return Rotation::FromRadians(0.0f);
 
+	if (precision == TrigonometryPrecision::Fast)
+		return Rotation::FromRadians(FirstLane(ArcTangentLanes(Simd::Wide::Broadcast(x), Simd::Wide::Broadcast(y))));
+
 	return Rotation::FromRadians(std::atan2(y, x));
 }
+
+void Pargon::ArcSine(const float* values, int count, Rotation* results, TrigonometryPrecision precision)
+{
+	if (precision == TrigonometryPrecision::Precise)
+	{
+		for (auto i = 0; i < count; i++)
+			results[i] = ArcSine(values[i]);
+
+		return;
+	}
+
+	ForEachBlock(count, [values, results](int index, int lanes)
+	{
+		Simd::Wide arcSine, arcCosine;
+		ArcSineLanes(LoadLanes(values + index, lanes), arcSine, arcCosine);
+		StoreLanes(arcSine, reinterpret_cast<float*>(results) + index, lanes);
+	});
+}
+
+void Pargon::ArcCosine(const float* values, int count, Rotation* results, TrigonometryPrecision precision)
+{
+	if (precision == TrigonometryPrecision::Precise)
+	{
+		for (auto i = 0; i < count; i++)
+			results[i] = ArcCosine(values[i]);
+
+		return;
+	}
+
+	ForEachBlock(count, [values, results](int index, int lanes)
+	{
+		Simd::Wide arcSine, arcCosine;
+		ArcSineLanes(LoadLanes(values + index, lanes), arcSine, arcCosine);
+		StoreLanes(arcCosine, reinterpret_cast<float*>(results) + index, lanes);
+	});
+}
+
+void Pargon::ArcTangent(const float* x, const float* y, int count, Rotation* results, TrigonometryPrecision precision)
+{
+	if (precision == TrigonometryPrecision::Precise)
+	{
+		for (auto i = 0; i < count; i++)
+			results[i] = ArcTangent(x[i], y[i]);
+
+		return;
+	}
+
+	ForEachBlock(count, [x, y, results](int index, int lanes)
+	{
+		StoreLanes(ArcTangentLanes(LoadLanes(x + index, lanes), LoadLanes(y + index, lanes)), reinterpret_cast<float*>(results) + index, lanes);
+	});
+}
@@ -2,17 +2,93 @@
 #include "Pargon/Math/Arithmetic.h"
 #include "Pargon/Math/Matrix.h"
 #include "Pargon/Math/Quaternion.h"
+#include "Pargon/Math/Stream.h"
 #include "Pargon/Math/Trigonometry.h"
 #include "Pargon/Math/Vector.h"
 #include "Pargon/Serialization/BufferReader.h"
 #include "Pargon/Serialization/BufferWriter.h"
 #include "Pargon/Serialization/StringReader.h"
 #include "Pargon/Serialization/StringWriter.h"
+#include "Core/Simd.h"
 
+#include <algorithm>
 #include <cml/cml.h>
+#include <limits>
 
 using namespace Pargon;
 
+namespace
+{
+	void NormalizeLanes(Simd::Wide& x, Simd::Wide& y, NormalizeAccuracy accuracy, Vector2 fallback)
+	{
+		auto lengthSquared = x * x + y * y;
+		auto zero = Simd::LessThan(lengthSquared, Simd::Wide::Broadcast(std::numeric_limits<float>::min()));
+
+		if (accuracy == NormalizeAccuracy::Fast)
+		{
+			auto scale = Simd::ReciprocalSquareRoot(lengthSquared);
+
+			x = x * scale;
+			y = y * scale;
+		}
+		else
+		{
+			auto length = Simd::SquareRoot(lengthSquared);
+
+			x = x / length;
+			y = y / length;
+		}
+
+		x = Simd::Select(zero, Simd::Wide::Broadcast(fallback.X), x);
+		y = Simd::Select(zero, Simd::Wide::Broadcast(fallback.Y), y);
+	}
+
+	void NormalizeLanes(Simd::Wide& x, Simd::Wide& y, Simd::Wide& z, NormalizeAccuracy accuracy, Vector3 fallback)
+	{
+		auto lengthSquared = x * x + y * y + z * z;
+		auto zero = Simd::LessThan(lengthSquared, Simd::Wide::Broadcast(std::numeric_limits<float>::min()));
+
+		if (accuracy == NormalizeAccuracy::Fast)
+		{
+			auto scale = Simd::ReciprocalSquareRoot(lengthSquared);
+
+			x = x * scale;
+			y = y * scale;
+			z = z * scale;
+		}
+		else
+		{
+			auto length = Simd::SquareRoot(lengthSquared);
+
+			x = x / length;
+			y = y / length;
+			z = z / length;
+		}
+
+		x = Simd::Select(zero, Simd::Wide::Broadcast(fallback.X), x);
+		y = Simd::Select(zero, Simd::Wide::Broadcast(fallback.Y), y);
+		z = Simd::Select(zero, Simd::Wide::Broadcast(fallback.Z), z);
+	}
+
+	void NormalizeBlock(float* vectors, NormalizeAccuracy accuracy, Vector2 fallback)
+	{
+		Simd::Wide x, y;
+
+		Simd::LoadInterleaved2(vectors, x, y);
+		NormalizeLanes(x, y, accuracy, fallback);
+		Simd::StoreInterleaved2(vectors, x, y);
+	}
+
+	void NormalizeBlock(float* vectors, NormalizeAccuracy accuracy, Vector3 fallback)
+	{
+		Simd::Wide x, y, z;
+
+		Simd::LoadInterleaved3(vectors, x, y, z);
+		NormalizeLanes(x, y, z, accuracy, fallback);
+		Simd::StoreInterleaved3(vectors, x, y, z);
+	}
+}
+
 auto Vector2::CreateNormalized(float x, float y) -> Vector2
 {
 	return Vector2{ x, y }.Normalized();
@@ -20,7 +96,8 @@ auto Vector2::CreateNormalized(float x, float y) -> Vector2
 
 auto Vector2::CreateFromDirection(Angle angle) -> Vector2
 {
-	return Vector2{ Cosine(angle), Sine(angle) };
+	auto direction = SineCosine(angle);
+	return Vector2{ direction.Cosine, direction.Sine };
 }
 
 auto Vector2::operator*=(const Matrix3x3& transform) -> Vector2&
@@ -260,3 +337,258 @@ void Vector3::FromString(StringReader& reader, StringView format)
 	if (!reader.Parse(_vector3Parse, X, Y, Z))
 		reader.ReportError("the string could not be read as a Vector3 (expected three floating point numbers separated by whitespace and/or a comma)");
 }
+
+void Pargon::TransformVectors(const Vector2* vectors, int count, const Matrix3x3& transform, Vector2* results)
+{
+	auto index = 0;
+
+#if PARGON_MATH_SSE
+	auto& m = transform.Elements;
+
+	auto m00 = _mm_set1_ps(m.Item(0)), m01 = _mm_set1_ps(m.Item(1));
+	auto m10 = _mm_set1_ps(m.Item(3)), m11 = _mm_set1_ps(m.Item(4));
+
+	for (; index + 4 <= count; index += 4)
+	{
+		__m128 x, y;
+		Simd::LoadInterleaved2(&vectors[index].X, x, y);
+
+		auto resultX = Simd::MultiplyAdd(y, m10, _mm_mul_ps(x, m00));
+		auto resultY = Simd::MultiplyAdd(y, m11, _mm_mul_ps(x, m01));
+
+		Simd::StoreInterleaved2(&results[index].X, resultX, resultY);
+	}
+#endif
+
+	for (; index < count; index++)
+		results[index] = vectors[index] * transform;
+}
+
+void Pargon::TransformVectors(const Vector3* vectors, int count, const Matrix4x4& transform, Vector3* results)
+{
+	auto index = 0;
+
+#if PARGON_MATH_SSE
+	auto& m = transform.Elements;
+
+	auto m00 = _mm_set1_ps(m.Item(0)), m01 = _mm_set1_ps(m.Item(1)), m02 = _mm_set1_ps(m.Item(2));
+	auto m10 = _mm_set1_ps(m.Item(4)), m11 = _mm_set1_ps(m.Item(5)), m12 = _mm_set1_ps(m.Item(6));
+	auto m20 = _mm_set1_ps(m.Item(8)), m21 = _mm_set1_ps(m.Item(9)), m22 = _mm_set1_ps(m.Item(10));
+
+	for (; index + 4 <= count; index += 4)
+	{
+		__m128 x, y, z;
+		Simd::LoadInterleaved3(&vectors[index].X, x, y, z);
+
+		auto resultX = Simd::MultiplyAdd(z, m20, Simd::MultiplyAdd(y, m10, _mm_mul_ps(x, m00)));
+		auto resultY = Simd::MultiplyAdd(z, m21, Simd::MultiplyAdd(y, m11, _mm_mul_ps(x, m01)));
+		auto resultZ = Simd::MultiplyAdd(z, m22, Simd::MultiplyAdd(y, m12, _mm_mul_ps(x, m02)));
+
+		Simd::StoreInterleaved3(&results[index].X, resultX, resultY, resultZ);
+	}
+#endif
+
+	for (; index < count; index++)
+		results[index] = vectors[index] * transform;
+}
+
+void Pargon::Normalize(Vector2* vectors, int count, NormalizeAccuracy accuracy, Vector2 fallback)
+{
+	auto index = 0;
+
+	for (; index + Simd::Wide::Width <= count; index += Simd::Wide::Width)
+		NormalizeBlock(&vectors[index].X, accuracy, fallback);
+
+	if (index < count)
+	{
+		float block[Simd::Wide::Width * 2] = {};
+		auto remaining = (count - index) * 2;
+
+		std::copy(&vectors[index].X, &vectors[index].X + remaining, block);
+		NormalizeBlock(block, accuracy, fallback);
+		std::copy(block, block + remaining, &vectors[index].X);
+	}
+}
+
+void Pargon::Normalize(Vector3* vectors, int count, NormalizeAccuracy accuracy, Vector3 fallback)
+{
+	auto index = 0;
+
+	for (; index + Simd::Wide::Width <= count; index += Simd::Wide::Width)
+		NormalizeBlock(&vectors[index].X, accuracy, fallback);
+
+	if (index < count)
+	{
+		float block[Simd::Wide::Width * 3] = {};
+		auto remaining = (count - index) * 3;
+
+		std::copy(&vectors[index].X, &vectors[index].X + remaining, block);
+		NormalizeBlock(block, accuracy, fallback);
+		std::copy(block, block + remaining, &vectors[index].X);
+	}
+}
+
+void Pargon::GetLengths(const Vector2Stream& vectors, FloatStream& results)
+{
+	results.SetCount(vectors.Count());
+
+	auto x = vectors.GetX();
+	auto y = vectors.GetY();
+	auto lengths = results.Data();
+
+	for (auto index = 0; index < vectors.PaddedCount(); index += Simd::Wide::Width)
+	{
+		auto vectorX = Simd::Wide::Load(x + index);
+		auto vectorY = Simd::Wide::Load(y + index);
+
+		Simd::SquareRoot(vectorX * vectorX + vectorY * vectorY).Store(lengths + index);
+	}
+}
+
+void Pargon::GetLengths(const Vector3Stream& vectors, FloatStream& results)
+{
+	results.SetCount(vectors.Count());
+
+	auto x = vectors.GetX();
+	auto y = vectors.GetY();
+	auto z = vectors.GetZ();
+	auto lengths = results.Data();
+
+	for (auto index = 0; index < vectors.PaddedCount(); index += Simd::Wide::Width)
+	{
+		auto vectorX = Simd::Wide::Load(x + index);
+		auto vectorY = Simd::Wide::Load(y + index);
+		auto vectorZ = Simd::Wide::Load(z + index);
+
+		Simd::SquareRoot(vectorX * vectorX + vectorY * vectorY + vectorZ * vectorZ).Store(lengths + index);
+	}
+}
+
+void Pargon::GetDotProducts(const Vector2Stream& left, const Vector2Stream& right, FloatStream& results)
+{
+	assert(left.Count() == right.Count());
+	results.SetCount(left.Count());
+
+	auto dots = results.Data();
+
+	for (auto index = 0; index < left.PaddedCount(); index += Simd::Wide::Width)
+	{
+		auto leftX = Simd::Wide::Load(left.GetX() + index);
+		auto leftY = Simd::Wide::Load(left.GetY() + index);
+		auto rightX = Simd::Wide::Load(right.GetX() + index);
+		auto rightY = Simd::Wide::Load(right.GetY() + index);
+
+		(leftX * rightX + leftY * rightY).Store(dots + index);
+	}
+}
+
+void Pargon::GetDotProducts(const Vector3Stream& left, const Vector3Stream& right, FloatStream& results)
+{
+	assert(left.Count() == right.Count());
+	results.SetCount(left.Count());
+
+	auto dots = results.Data();
+
+	for (auto index = 0; index < left.PaddedCount(); index += Simd::Wide::Width)
+	{
+		auto leftX = Simd::Wide::Load(left.GetX() + index);
+		auto leftY = Simd::Wide::Load(left.GetY() + index);
+		auto leftZ = Simd::Wide::Load(left.GetZ() + index);
+		auto rightX = Simd::Wide::Load(right.GetX() + index);
+		auto rightY = Simd::Wide::Load(right.GetY() + index);
+		auto rightZ = Simd::Wide::Load(right.GetZ() + index);
+
+		(leftX * rightX + leftY * rightY + leftZ * rightZ).Store(dots + index);
+	}
+}
+
+void Pargon::GetCrossProducts(const Vector3Stream& left, const Vector3Stream& right, Vector3Stream& results)
+{
+	assert(left.Count() == right.Count());
+	results.SetCount(left.Count());
+
+	for (auto index = 0; index < left.PaddedCount(); index += Simd::Wide::Width)
+	{
+		auto leftX = Simd::Wide::Load(left.GetX() + index);
+		auto leftY = Simd::Wide::Load(left.GetY() + index);
+		auto leftZ = Simd::Wide::Load(left.GetZ() + index);
+		auto rightX = Simd::Wide::Load(right.GetX() + index);
+		auto rightY = Simd::Wide::Load(right.GetY() + index);
+		auto rightZ = Simd::Wide::Load(right.GetZ() + index);
+
+		(leftY * rightZ - leftZ * rightY).Store(results.GetX() + index);
+		(leftZ * rightX - leftX * rightZ).Store(results.GetY() + index);
+		(leftX * rightY - leftY * rightX).Store(results.GetZ() + index);
+	}
+}
+
+void Pargon::Normalize(Vector2Stream& vectors, NormalizeAccuracy accuracy, Vector2 fallback)
+{
+	for (auto index = 0; index < vectors.PaddedCount(); index += Simd::Wide::Width)
+	{
+		auto x = Simd::Wide::Load(vectors.GetX() + index);
+		auto y = Simd::Wide::Load(vectors.GetY() + index);
+
+		NormalizeLanes(x, y, accuracy, fallback);
+
+		x.Store(vectors.GetX() + index);
+		y.Store(vectors.GetY() + index);
+	}
+}
+
+void Pargon::Normalize(Vector3Stream& vectors, NormalizeAccuracy accuracy, Vector3 fallback)
+{
+	for (auto index = 0; index < vectors.PaddedCount(); index += Simd::Wide::Width)
+	{
+		auto x = Simd::Wide::Load(vectors.GetX() + index);
+		auto y = Simd::Wide::Load(vectors.GetY() + index);
+		auto z = Simd::Wide::Load(vectors.GetZ() + index);
+
+		NormalizeLanes(x, y, z, accuracy, fallback);
+
+		x.Store(vectors.GetX() + index);
+		y.Store(vectors.GetY() + index);
+		z.Store(vectors.GetZ() + index);
+	}
+}
+
+void Pargon::TransformVectors(const Vector2Stream& vectors, const Matrix3x3& transform, Vector2Stream& results)
+{
+	results.SetCount(vectors.Count());
+
+	auto& m = transform.Elements;
+
+	auto m00 = Simd::Wide::Broadcast(m.Item(0)), m01 = Simd::Wide::Broadcast(m.Item(1));
+	auto m10 = Simd::Wide::Broadcast(m.Item(3)), m11 = Simd::Wide::Broadcast(m.Item(4));
+
+	for (auto index = 0; index < vectors.PaddedCount(); index += Simd::Wide::Width)
+	{
+		auto x = Simd::Wide::Load(vectors.GetX() + index);
+		auto y = Simd::Wide::Load(vectors.GetY() + index);
+
+		Simd::MultiplyAdd(y, m10, x * m00).Store(results.GetX() + index);
+		Simd::MultiplyAdd(y, m11, x * m01).Store(results.GetY() + index);
+	}
+}
+
+void Pargon::TransformVectors(const Vector3Stream& vectors, const Matrix4x4& transform, Vector3Stream& results)
+{
+	results.SetCount(vectors.Count());
+
+	auto& m = transform.Elements;
+
+	auto m00 = Simd::Wide::Broadcast(m.Item(0)), m01 = Simd::Wide::Broadcast(m.Item(1)), m02 = Simd::Wide::Broadcast(m.Item(2));
+	auto m10 = Simd::Wide::Broadcast(m.Item(4)), m11 = Simd::Wide::Broadcast(m.Item(5)), m12 = Simd::Wide::Broadcast(m.Item(6));
+	auto m20 = Simd::Wide::Broadcast(m.Item(8)), m21 = Simd::Wide::Broadcast(m.Item(9)), m22 = Simd::Wide::Broadcast(m.Item(10));
+
+	for (auto index = 0; index < vectors.PaddedCount(); index += Simd::Wide::Width)
+	{
+		auto x = Simd::Wide::Load(vectors.GetX() + index);
+		auto y = Simd::Wide::Load(vectors.GetY() + index);
+		auto z = Simd::Wide::Load(vectors.GetZ() + index);
+
+		Simd::MultiplyAdd(z, m20, Simd::MultiplyAdd(y, m10, x * m00)).Store(results.GetX() + index);
+		Simd::MultiplyAdd(z, m21, Simd::MultiplyAdd(y, m11, x * m01)).Store(results.GetY() + index);
+		Simd::MultiplyAdd(z, m22, Simd::MultiplyAdd(y, m12, x * m02)).Store(results.GetZ() + index);
+	}
+}